@@ -0,0 +1,55 @@
+#include "GzipOutputStream.h"
+
+#ifdef ROBUSTOPTIMIZATION_WITH_ZLIB
+
+#include "helpers.h"
+
+namespace helpers {
+
+GzipOutputStream::Buffer::Buffer(std::string const& file_name, size_t const buffer_size) :
+        _file(gzopen(file_name.c_str(), "wb")), _buffer(buffer_size) {
+    exception_check(_file != nullptr, "Could not open " + file_name + " for writing!");
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+GzipOutputStream::Buffer::~Buffer() {
+    flush_buffer();
+    gzclose(_file);
+}
+
+GzipOutputStream::Buffer::int_type GzipOutputStream::Buffer::overflow(int_type const character) {
+    if (not flush_buffer()) {
+        return traits_type::eof();
+    }
+    if (not traits_type::eq_int_type(character, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(character);
+        pbump(1);
+    }
+    return traits_type::not_eof(character);
+}
+
+int GzipOutputStream::Buffer::sync() {
+    return flush_buffer() ? 0 : -1;
+}
+
+bool GzipOutputStream::Buffer::flush_buffer() {
+    int const size = int(pptr() - pbase());
+    if (size > 0 and gzwrite(_file, pbase(), unsigned(size)) != size) {
+        return false;
+    }
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    return true;
+}
+
+GzipOutputStream::GzipOutputStream(std::string const& file_name, size_t const buffer_size) :
+        std::ostream(nullptr), _buffer(file_name, buffer_size) {
+    rdbuf(&_buffer);
+}
+
+GzipOutputStream::~GzipOutputStream() {
+    flush();
+}
+
+}
+
+#endif
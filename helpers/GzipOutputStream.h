@@ -0,0 +1,53 @@
+#ifndef ROBUSTOPTIMIZATION_GZIPOUTPUTSTREAM_H
+#define ROBUSTOPTIMIZATION_GZIPOUTPUTSTREAM_H
+
+#ifdef ROBUSTOPTIMIZATION_WITH_ZLIB
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+namespace helpers {
+
+// Output stream, which writes a gzip compressed file through a buffer. Only available, when built with zlib.
+class GzipOutputStream : public std::ostream {
+public:
+    explicit GzipOutputStream(std::string const& file_name, size_t buffer_size = 1 << 16);
+
+    GzipOutputStream(GzipOutputStream const&) = delete;
+    GzipOutputStream& operator=(GzipOutputStream const&) = delete;
+
+    ~GzipOutputStream() override;
+
+private:
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(std::string const& file_name, size_t buffer_size);
+
+        ~Buffer() override;
+
+    protected:
+        int_type overflow(int_type character) override;
+
+        int sync() override;
+
+    private:
+        bool flush_buffer();
+
+    private:
+        gzFile _file;
+        std::vector<char> _buffer;
+    };
+
+private:
+    Buffer _buffer;
+};
+
+}
+
+#endif
+
+#endif //ROBUSTOPTIMIZATION_GZIPOUTPUTSTREAM_H
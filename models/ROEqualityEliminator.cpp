@@ -0,0 +1,248 @@
+#include "ROEqualityEliminator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace robust_model {
+
+ROEqualityEliminator::ROEqualityEliminator(ROModel const& model) :
+        _model(model),
+        _reduced_model("Reduced " + model.name()),
+        _eliminated(model.num_dvars(), false),
+        _protected(model.num_dvars(), false),
+        _eliminating_constraints(model.constraints().size(), false) {
+    for (auto const& dvar: _model.decision_variables()) {
+        _substitutions.emplace_back(dvar.reference());
+        _dependencies.emplace_back();
+        for (auto const& uvar: dvar.dependencies()) {
+            _dependencies.back().push_back(uvar.raw_id());
+        }
+        std::sort(_dependencies.back().begin(), _dependencies.back().end());
+    }
+    auto const protect = [&](RoAffineExpression const& expr) {
+        for (auto const& usdvar: expr.uncertainty_decisions().scaled_variables()) {
+            _protected[usdvar.variable().decision_variable().raw_id()] = true;
+        }
+    };
+    for (auto const& constr: _model.constraints()) {
+        protect(constr.expression());
+    }
+    protect(_model.objective().expression());
+
+    eliminate_variables();
+    build_reduced_model();
+}
+
+ROModel const& ROEqualityEliminator::reduced_model() const {
+    return _reduced_model;
+}
+
+size_t ROEqualityEliminator::num_eliminated_variables() const {
+    return _eliminated_variables.size();
+}
+
+DecisionVariable const& ROEqualityEliminator::original_variable(DecisionVariable const& reduced_dvar) const {
+    return _model.decision_variables().at(_original_variables.at(reduced_dvar.id().raw_id()));
+}
+
+std::string ROEqualityEliminator::statistics_string() const {
+    return "Equality elimination removed " + std::to_string(num_eliminated_variables()) + " of "
+           + std::to_string(_model.num_dvars()) + " decision variables and their defining constraints";
+}
+
+void ROEqualityEliminator::eliminate_variables() {
+    for (size_t i = 0; i < _model.constraints().size(); ++i) {
+        auto const& constr = _model.constraints()[i];
+        if (constr.sense() != ConstraintSense::EQ or
+            constr.expression().uncertainty_behaviour() == RoAffineExpression::UncertaintyBehaviour::STOCHASTIC) {
+            continue;
+        }
+        auto const expr = substituted(constr.expression());
+        if (not expr.uncertainty_decisions().empty()) {
+            continue;
+        }
+        auto const dvar = defined_variable(expr);
+        if (not dvar) {
+            continue;
+        }
+        size_t const x = dvar.value();
+        double scale = 0;
+        LinearExpression<DecisionVariable::Reference> rest;
+        for (auto const& sdvar: expr.decisions().scaled_variables()) {
+            if (sdvar.variable().raw_id() == x) {
+                scale = sdvar.scale();
+            } else {
+                rest += sdvar;
+            }
+        }
+        _substitutions[x] = RoAffineExpression(expr.constant(), rest, expr.uncertainties()) * (-1. / scale);
+        _eliminated[x] = true;
+        _eliminating_constraints[i] = true;
+        _eliminated_variables.push_back(x);
+        // earlier definitions may contain x, they are kept in terms of the remaining decisions
+        for (size_t const eliminated: _eliminated_variables) {
+            if (eliminated != x and contains(_substitutions[eliminated], x)) {
+                _substitutions[eliminated] = substituted(_substitutions[eliminated]);
+            }
+        }
+    }
+}
+
+std::optional<size_t> ROEqualityEliminator::defined_variable(RoAffineExpression const& expr) const {
+    std::optional<size_t> defined;
+    double largest_scale = TOLERANCE;
+    for (auto const& candidate: expr.decisions().scaled_variables()) {
+        size_t const x = candidate.variable().raw_id();
+        if (_protected[x] or std::abs(candidate.scale()) <= largest_scale) {
+            continue;
+        }
+        bool const uncertainties_contained = std::all_of(
+                expr.uncertainties().scaled_variables().begin(), expr.uncertainties().scaled_variables().end(),
+                [&](auto const& suvar) { return depends_on(x, suvar.variable()); });
+        bool const dependencies_contained = std::all_of(
+                expr.decisions().scaled_variables().begin(), expr.decisions().scaled_variables().end(),
+                [&](auto const& sdvar) {
+                    auto const& dependencies = _dependencies[sdvar.variable().raw_id()];
+                    return std::includes(_dependencies[x].begin(), _dependencies[x].end(),
+                                         dependencies.begin(), dependencies.end());
+                });
+        if (uncertainties_contained and dependencies_contained) {
+            defined = x;
+            largest_scale = std::abs(candidate.scale());
+        }
+    }
+    return defined;
+}
+
+bool ROEqualityEliminator::depends_on(size_t const dvar, UncertaintyVariable::Reference const& uvar) const {
+    return std::binary_search(_dependencies[dvar].begin(), _dependencies[dvar].end(), uvar.raw_id());
+}
+
+RoAffineExpression ROEqualityEliminator::substituted(RoAffineExpression const& expr) const {
+    RoAffineExpression result(expr.constant(), LinearExpression<DecisionVariable::Reference>(), expr.uncertainties(),
+                              expr.uncertainty_decisions());
+    for (auto const& sdvar: expr.decisions().scaled_variables()) {
+        result += sdvar.scale() * _substitutions[sdvar.variable().raw_id()];
+    }
+    result.set_multi_uncertainty_behaviour(expr.uncertainty_behaviour());
+    return merged(result);
+}
+
+RoAffineExpression ROEqualityEliminator::merged(RoAffineExpression const& expr) const {
+    std::map<size_t, double> decisions;
+    std::map<size_t, double> uncertainties;
+    for (auto const& sdvar: expr.decisions().scaled_variables()) {
+        decisions[sdvar.variable().raw_id()] += sdvar.scale();
+    }
+    for (auto const& suvar: expr.uncertainties().scaled_variables()) {
+        uncertainties[suvar.variable().raw_id()] += suvar.scale();
+    }
+    LinearExpression<DecisionVariable::Reference> merged_decisions;
+    for (auto const& [dvar, scale]: decisions) {
+        if (std::abs(scale) > TOLERANCE) {
+            merged_decisions += scale * _model.decision_variables()[dvar].reference();
+        }
+    }
+    LinearExpression<UncertaintyVariable::Reference> merged_uncertainties;
+    for (auto const& [uvar, scale]: uncertainties) {
+        if (std::abs(scale) > TOLERANCE) {
+            merged_uncertainties += scale * _model.uncertainty_variables()[uvar].reference();
+        }
+    }
+    return {expr.constant(), merged_decisions, merged_uncertainties, expr.uncertainty_decisions(),
+            expr.uncertainty_behaviour()};
+}
+
+bool ROEqualityEliminator::contains(RoAffineExpression const& expr, size_t const dvar) {
+    return std::any_of(expr.decisions().scaled_variables().begin(), expr.decisions().scaled_variables().end(),
+                       [dvar](auto const& sdvar) { return sdvar.variable().raw_id() == dvar; });
+}
+
+void ROEqualityEliminator::build_reduced_model() {
+    for (auto const& uvar: _model.uncertainty_variables()) {
+        _reduced_uncertainties.emplace_back(_reduced_model.add_uncertainty_variable(
+                uvar.name(), uvar.has_period() ? uvar.period() : std::optional<period_id>{}, uvar.lb(), uvar.ub()));
+    }
+    for (auto const union_set: _model.uncertainty_set().constraint_sets()) {
+        if (union_set.raw_id() > 0) {
+            _reduced_model.add_uncertainty_constraint_set();
+        }
+        auto const reduced_union_set = _reduced_model.uncertainty_set().constraint_sets().back();
+        for (auto const& uconstr: _model.uncertainty_set().uncertainty_constraints(union_set)) {
+            _reduced_model.add_uncertainty_constraint(uconstr.substitute<UncertaintyVariable>(_reduced_uncertainties),
+                                                      reduced_union_set);
+        }
+    }
+    if (_model.has_expectation_provider()) {
+        _reduced_model.set_expectation_provider(
+                std::make_unique<SOExpectationProviderReference>(_model.expectation_provider()));
+    }
+
+    for (auto const& dvar: _model.decision_variables()) {
+        if (_eliminated[dvar.id().raw_id()]) {
+            _reduced_decisions.emplace_back();
+            continue;
+        }
+        _original_variables.push_back(dvar.id().raw_id());
+        if (dvar.has_period()) {
+            _reduced_decisions.emplace_back(
+                    _reduced_model.add_decision_variable(dvar.name(), dvar.period(), dvar.lb(), dvar.ub()));
+            continue;
+        }
+        std::vector<UncertaintyVariable::Reference> dependencies;
+        for (auto const& uvar: dvar.dependencies()) {
+            dependencies.push_back(_reduced_model.uncertainty_variables()[uvar.raw_id()].reference());
+        }
+        _reduced_decisions.emplace_back(
+                _reduced_model.add_decision_variable(dvar.name(), dependencies, dvar.lb(), dvar.ub()));
+    }
+
+    for (size_t i = 0; i < _model.constraints().size(); ++i) {
+        if (_eliminating_constraints[i]) {
+            continue;
+        }
+        auto const& constr = _model.constraints()[i];
+        _reduced_model.add_constraint({constr.name(), constr.sense(), reduced_expression(constr.expression())});
+    }
+    for (size_t const x: _eliminated_variables) {
+        auto const& dvar = _model.decision_variables()[x];
+        if (dvar.lb() != NO_VARIABLE_LB) {
+            _reduced_model.add_constraint(reduced_expression(_substitutions[x]) >= dvar.lb(), "LB_" + dvar.name());
+        }
+        if (dvar.ub() != NO_VARIABLE_UB) {
+            _reduced_model.add_constraint(reduced_expression(_substitutions[x]) <= dvar.ub(), "UB_" + dvar.name());
+        }
+    }
+    _reduced_model.set_objective(reduced_expression(_model.objective().expression()), _model.objective().sense());
+}
+
+RoAffineExpression ROEqualityEliminator::reduced_expression(RoAffineExpression const& expr) const {
+    return substituted(expr).substitute(_reduced_decisions, _reduced_uncertainties);
+}
+
+std::vector<double> ROEqualityEliminator::original_solutions(SolutionRealization const& reduced_solution) const {
+    auto const& realization = reduced_solution.realization();
+    std::vector<double> solutions(_model.num_dvars(), 0.);
+    size_t reduced_dvar = 0;
+    for (size_t i = 0; i < _model.num_dvars(); ++i) {
+        if (not _eliminated[i]) {
+            solutions[i] = reduced_solution.solutions().at(reduced_dvar++);
+        }
+    }
+    // the definitions only contain kept decisions
+    for (size_t const x: _eliminated_variables) {
+        auto const& definition = _substitutions[x];
+        double value = definition.constant();
+        for (auto const& sdvar: definition.decisions().scaled_variables()) {
+            value += sdvar.scale() * solutions[sdvar.variable().raw_id()];
+        }
+        for (auto const& suvar: definition.uncertainties().scaled_variables()) {
+            value += suvar.scale() * realization.at(suvar.variable().raw_id());
+        }
+        solutions[x] = value;
+    }
+    return solutions;
+}
+
+}
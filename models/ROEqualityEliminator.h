@@ -0,0 +1,82 @@
+#ifndef ROBUSTOPTIMIZATION_ROEQUALITYELIMINATOR_H
+#define ROBUSTOPTIMIZATION_ROEQUALITYELIMINATOR_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ROModel.h"
+#include "basic_model_objects/SolutionRealization.h"
+
+namespace robust_model {
+
+// Eliminates decision variables, which are defined by an equality constraint, from a ROModel.
+// An equality  s * x + rest == 0  defines x = -rest / s, if the dependencies of x contain the uncertainty variables
+// of rest and the dependencies of its decisions. Every affine policy of the remaining decisions then gives an affine
+// policy of x and the coefficient matching of the equality holds by construction.
+// Decisions of uncertainty scaled decisions are kept. x is substituted in all other constraints and the objective,
+// its bounds become constraints on its definition.
+// The reduced model copies the uncertainty set, its expectation provider refers to the one of the original model.
+// Changes of the original model after the construction are not passed on.
+class ROEqualityEliminator {
+public:
+    explicit ROEqualityEliminator(ROModel const& model);
+
+    ROModel const& reduced_model() const;
+
+    size_t num_eliminated_variables() const;
+
+    DecisionVariable const& original_variable(DecisionVariable const& reduced_dvar) const;
+
+    std::string statistics_string() const;
+
+    // values of the decisions of the original model for a solution realization of the reduced model
+    std::vector<double> original_solutions(SolutionRealization const& reduced_solution) const;
+
+private:
+    void eliminate_variables();
+
+    // the decision with the largest coefficient, whose dependencies contain all other dependencies of expr
+    std::optional<size_t> defined_variable(RoAffineExpression const& expr) const;
+
+    bool depends_on(size_t dvar, UncertaintyVariable::Reference const& uvar) const;
+
+    // expr with every decision replaced by its substitution, duplicate variables are merged
+    RoAffineExpression substituted(RoAffineExpression const& expr) const;
+
+    RoAffineExpression merged(RoAffineExpression const& expr) const;
+
+    static bool contains(RoAffineExpression const& expr, size_t dvar);
+
+    void build_reduced_model();
+
+    // expr of the original model in the variables of the reduced model
+    RoAffineExpression reduced_expression(RoAffineExpression const& expr) const;
+
+private:
+    ROModel const& _model;
+    ROModel _reduced_model;
+
+    // definition of every decision by the kept decisions and the uncertainty variables, the identity if kept
+    std::vector<RoAffineExpression> _substitutions;
+    std::vector<bool> _eliminated;
+    // decisions of uncertainty scaled decisions, their product with a definition would not be affine
+    std::vector<bool> _protected;
+    // raw ids of the dependencies of every decision, sorted
+    std::vector<std::vector<size_t>> _dependencies;
+    std::vector<bool> _eliminating_constraints;
+    // in the order of elimination
+    std::vector<size_t> _eliminated_variables;
+
+    std::vector<AffineExpression<DecisionVariable::Reference>> _reduced_decisions;
+    // raw id of the original decision of every reduced decision
+    std::vector<size_t> _original_variables;
+    std::vector<AffineExpression<UncertaintyVariable::Reference>> _reduced_uncertainties;
+
+    // coefficients up to this size are treated as zero
+    static constexpr double TOLERANCE = 1e-12;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_ROEQUALITYELIMINATOR_H
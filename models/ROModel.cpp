@@ -126,6 +126,15 @@ std::vector<DecisionVariable::Index> const& ROModel::decision_variable_ids() con
     return ids();
 }
 
+void ROModel::set_uncertainty_constraint_constant(UncertaintySetConstraintsSet::Index union_set,
+                                                  size_t const constraint_number, double const constant) {
+    _uncertainty_set.set_uncertainty_constraint_constant(union_set, constraint_number, constant);
+}
+
+void ROModel::set_uncertainty_variable_bounds(UncertaintyVariable::Index const& uvar, double const lb, double const ub) {
+    _uncertainty_set.set_variable_bounds(uvar, lb, ub);
+}
+
 UncertaintySet const& ROModel::uncertainty_set() const {
     return _uncertainty_set;
 }
@@ -74,6 +74,12 @@ public:
     }
 
 
+    // parameters of the uncertainty set, which may be changed after the model is built by a solver
+    void set_uncertainty_constraint_constant(UncertaintySetConstraintsSet::Index union_set, size_t constraint_number,
+                                             double constant);
+
+    void set_uncertainty_variable_bounds(UncertaintyVariable::Index const& uvar, double lb, double ub);
+
     void set_objective(RoAffineExpression const& objective, Objective::Sense sense);
 
     std::string full_string() const;
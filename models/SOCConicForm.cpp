@@ -0,0 +1,221 @@
+#include <algorithm>
+
+#include "SOCConicForm.h"
+
+namespace robust_model {
+
+SOCConicForm::SOCConicForm(SOCModel const& model) :
+        _num_model_variables(model.variables().size()),
+        _num_columns(model.variables().size()),
+        _objective(model.variables().size(), 0.),
+        _objective_constant(model.objective().expression().constant()),
+        _maximize(model.objective().sense() == ObjectiveSense::MAX),
+        _constraint_block_rows(model.soc_constraints().size(), {nullptr, 0}),
+        _constraint_row_signs(model.soc_constraints().size(), 0.) {
+    helpers::exception_check(not model.is_multi_objective(), "Conic form is only available for single objectives!");
+    helpers::exception_check(model.sos_constraints().empty(), "Conic form does not support sos constraints!");
+
+    double const objective_sign = _maximize ? -1. : 1.;
+    for (auto const& svar: model.objective().expression().linear().scaled_variables()) {
+        _objective[svar.variable().raw_id()] += objective_sign * svar.scale();
+    }
+    for (auto const& var: model.variables()) {
+        add_variable_bounds(var);
+    }
+    for (size_t i = 0; i < model.soc_constraints().size(); ++i) {
+        add_constraint(model.soc_constraints()[i], i);
+    }
+    assemble();
+}
+
+void SOCConicForm::add_constraint(SOCModel::Constraint const& constr, size_t constraint_number) {
+    auto const& affine = constr.soc_expression().affine();
+    Terms terms;
+    if (constr.soc_expression().is_affine()) {
+        double const sign = constr.sense() == ConstraintSense::GEQ ? -1. : 1.;
+        double const constant = append(terms, affine, sign);
+        auto& block = constr.sense() == ConstraintSense::EQ ? _zero_rows : _nonnegative_rows;
+        _constraint_block_rows[constraint_number] = {&block, add_row(block, terms, constant)};
+        _constraint_row_signs[constraint_number] = sign;
+        return;
+    }
+    helpers::exception_check(constr.sense() == ConstraintSense::LEQ,
+                             "Normed constraint " + constr.name() + " is not convex!");
+    auto const& normed_vector = constr.soc_expression().normed_vector().normed_vector();
+    switch (constr.soc_expression().normed_vector().norm_type()) {
+        case VectorNormType::Two: {
+            double constant = append(terms, affine, 1.);
+            add_row(_second_order_cone_rows, terms, constant);
+            for (auto const& entry: normed_vector) {
+                constant = append(terms, entry, -1.);
+                add_row(_second_order_cone_rows, terms, constant);
+            }
+            _second_order_cone_sizes.emplace_back(normed_vector.size() + 1);
+            return;
+        }
+        case VectorNormType::One: {
+            Terms sum_terms;
+            for (auto const& entry: normed_vector) {
+                int const abs = add_auxiliary_column();
+                for (double const sign: {1., -1.}) {
+                    double const constant = append(terms, entry, sign);
+                    terms.emplace_back(abs, -1.);
+                    add_row(_nonnegative_rows, terms, constant);
+                }
+                sum_terms.emplace_back(abs, 1.);
+            }
+            double const constant = append(sum_terms, affine, 1.);
+            add_row(_nonnegative_rows, sum_terms, constant);
+            return;
+        }
+        case VectorNormType::Max: {
+            for (auto const& entry: normed_vector) {
+                for (double const sign: {1., -1.}) {
+                    double const constant = append(terms, entry, sign) + append(terms, affine, 1.);
+                    add_row(_nonnegative_rows, terms, constant);
+                }
+            }
+            return;
+        }
+    }
+}
+
+void SOCConicForm::add_variable_bounds(SOCVariable const& var) {
+    int const column = int(var.id().raw_id());
+    Terms terms;
+    if (var.lb() == var.ub()) {
+        terms.emplace_back(column, 1.);
+        add_row(_zero_rows, terms, -var.lb());
+        return;
+    }
+    if (var.lb() != NO_VARIABLE_LB) {
+        terms.emplace_back(column, -1.);
+        add_row(_nonnegative_rows, terms, var.lb());
+    }
+    if (var.ub() != NO_VARIABLE_UB) {
+        terms.emplace_back(column, 1.);
+        add_row(_nonnegative_rows, terms, -var.ub());
+    }
+}
+
+int SOCConicForm::add_auxiliary_column() {
+    _objective.emplace_back(0.);
+    return int(_num_columns++);
+}
+
+double SOCConicForm::append(Terms& terms, AffineExpression<SOCVariable::Reference> const& affine, double scale) {
+    for (auto const& svar: affine.linear().scaled_variables()) {
+        terms.emplace_back(int(svar.variable().raw_id()), scale * svar.scale());
+    }
+    return scale * affine.constant();
+}
+
+size_t SOCConicForm::add_row(RowBlock& block, Terms& terms, double constant) {
+    std::sort(terms.begin(), terms.end(),
+              [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+    for (auto const& [column, value]: terms) {
+        if (not block.column_indices.empty() and block.row_starts.back() < int(block.column_indices.size())
+            and block.column_indices.back() == column) {
+            block.values.back() += value;
+            continue;
+        }
+        block.column_indices.emplace_back(column);
+        block.values.emplace_back(value);
+    }
+    terms.clear();
+    block.row_starts.emplace_back(int(block.column_indices.size()));
+    block.rhs.emplace_back(-constant);
+    return block.rhs.size() - 1;
+}
+
+void SOCConicForm::assemble() {
+    size_t const num_nonzeros = _zero_rows.values.size() + _nonnegative_rows.values.size()
+                                + _second_order_cone_rows.values.size();
+    _row_starts = {0};
+    _row_starts.reserve(num_rows() + 1);
+    _column_indices.reserve(num_nonzeros);
+    _values.reserve(num_nonzeros);
+    _rhs.reserve(num_rows());
+    std::vector<std::pair<RowBlock const*, size_t>> block_offsets;
+    for (RowBlock const* block: {&_zero_rows, &_nonnegative_rows, &_second_order_cone_rows}) {
+        block_offsets.emplace_back(block, _rhs.size());
+        int const nonzero_offset = int(_column_indices.size());
+        for (size_t r = 1; r < block->row_starts.size(); ++r) {
+            _row_starts.emplace_back(nonzero_offset + block->row_starts[r]);
+        }
+        _column_indices.insert(_column_indices.end(), block->column_indices.begin(), block->column_indices.end());
+        _values.insert(_values.end(), block->values.begin(), block->values.end());
+        _rhs.insert(_rhs.end(), block->rhs.begin(), block->rhs.end());
+    }
+    _constraint_rows.assign(_constraint_block_rows.size(), -1);
+    for (size_t i = 0; i < _constraint_block_rows.size(); ++i) {
+        for (auto const& [block, offset]: block_offsets) {
+            if (_constraint_block_rows[i].first == block) {
+                _constraint_rows[i] = int(offset + _constraint_block_rows[i].second);
+            }
+        }
+    }
+    _constraint_block_rows.clear();
+}
+
+size_t SOCConicForm::num_columns() const {
+    return _num_columns;
+}
+
+size_t SOCConicForm::num_model_variables() const {
+    return _num_model_variables;
+}
+
+size_t SOCConicForm::num_rows() const {
+    return _zero_rows.rhs.size() + _nonnegative_rows.rhs.size() + _second_order_cone_rows.rhs.size();
+}
+
+size_t SOCConicForm::num_zero_rows() const {
+    return _zero_rows.rhs.size();
+}
+
+size_t SOCConicForm::num_nonnegative_rows() const {
+    return _nonnegative_rows.rhs.size();
+}
+
+std::vector<size_t> const& SOCConicForm::second_order_cone_sizes() const {
+    return _second_order_cone_sizes;
+}
+
+std::vector<int> const& SOCConicForm::row_starts() const {
+    return _row_starts;
+}
+
+std::vector<int> const& SOCConicForm::column_indices() const {
+    return _column_indices;
+}
+
+std::vector<double> const& SOCConicForm::values() const {
+    return _values;
+}
+
+std::vector<double> const& SOCConicForm::rhs() const {
+    return _rhs;
+}
+
+std::vector<double> const& SOCConicForm::objective() const {
+    return _objective;
+}
+
+double SOCConicForm::objective_constant() const {
+    return _objective_constant;
+}
+
+bool SOCConicForm::maximize() const {
+    return _maximize;
+}
+
+std::vector<int> const& SOCConicForm::constraint_rows() const {
+    return _constraint_rows;
+}
+
+std::vector<double> const& SOCConicForm::constraint_row_signs() const {
+    return _constraint_row_signs;
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef ROBUSTOPTIMIZATION_SOCCONICFORM_H
+#define ROBUSTOPTIMIZATION_SOCCONICFORM_H
+
+#include <utility>
+#include <vector>
+
+#include "SOCModel.h"
+
+namespace robust_model {
+
+// Conic standard form  min c^T x  s.t.  A x + s = b,  s in K  of a single objective SOCModel without sos constraints.
+// Integrality of the model variables is not part of the form.
+// The rows of A are ordered by cone: zero cone, nonnegative cone and second order cones (t, w) with ||w|| <= t.
+// A is stored in compressed sparse row format. The first columns are the model variables,
+// one norm constraints add auxiliary columns behind them. Maximization objectives are negated.
+class SOCConicForm {
+public:
+    explicit SOCConicForm(SOCModel const& model);
+
+    size_t num_columns() const;
+
+    size_t num_model_variables() const;
+
+    size_t num_rows() const;
+
+    size_t num_zero_rows() const;
+
+    size_t num_nonnegative_rows() const;
+
+    std::vector<size_t> const& second_order_cone_sizes() const;
+
+    std::vector<int> const& row_starts() const;
+
+    std::vector<int> const& column_indices() const;
+
+    std::vector<double> const& values() const;
+
+    std::vector<double> const& rhs() const;
+
+    std::vector<double> const& objective() const;
+
+    double objective_constant() const;
+
+    bool maximize() const;
+
+    // row of each affine soc constraint and the sign, with which it was added; -1 for other constraints
+    std::vector<int> const& constraint_rows() const;
+
+    std::vector<double> const& constraint_row_signs() const;
+
+private:
+    struct RowBlock {
+        std::vector<int> row_starts = {0};
+        std::vector<int> column_indices;
+        std::vector<double> values;
+        std::vector<double> rhs;
+    };
+
+    using Terms = std::vector<std::pair<int, double>>;
+
+    void add_constraint(SOCModel::Constraint const& constr, size_t constraint_number);
+
+    void add_variable_bounds(SOCVariable const& var);
+
+    int add_auxiliary_column();
+
+    // appends scale * affine to the terms and returns the scaled constant
+    static double append(Terms& terms, AffineExpression<SOCVariable::Reference> const& affine, double scale);
+
+    // adds the row  terms^T x + s = -constant  and returns its position in the block, duplicate columns are merged
+    static size_t add_row(RowBlock& block, Terms& terms, double constant);
+
+    void assemble();
+
+private:
+    size_t _num_model_variables;
+    size_t _num_columns;
+
+    RowBlock _zero_rows;
+    RowBlock _nonnegative_rows;
+    RowBlock _second_order_cone_rows;
+    std::vector<size_t> _second_order_cone_sizes;
+
+    std::vector<int> _row_starts;
+    std::vector<int> _column_indices;
+    std::vector<double> _values;
+    std::vector<double> _rhs;
+
+    std::vector<double> _objective;
+    double _objective_constant;
+    bool _maximize;
+
+    // rows are only known within their block until assembly
+    std::vector<std::pair<RowBlock const*, size_t>> _constraint_block_rows;
+    std::vector<int> _constraint_rows;
+    std::vector<double> _constraint_row_signs;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_SOCCONICFORM_H
@@ -3,8 +3,8 @@
 #include <utility>
 #include <cmath>
 #include <algorithm>
-#include "gurobi_c++.h"
-#include "../solvers/soc_solvers/GurobiSOCSolver.h"
+#include <sstream>
+#include <unordered_set>
 
 namespace robust_model {
 
@@ -34,9 +34,14 @@ std::vector<SOCModel::Objective> const& SOCModel::objectives() const {
 
 void SOCModel::clear_and_set_objective(SOCModel::Objective const& objective) {
     _objectives.clear();
+    ++_objective_revision;
     add_objective(objective);
 }
 
+size_t SOCModel::objective_revision() const {
+    return _objective_revision;
+}
+
 void
 SOCModel::add_objective(Objective const& objective) {
     _objectives.emplace_back(objective);
@@ -89,6 +94,98 @@ void SOCModel::add_sos_constraint(std::vector<SOCVariable::Reference> const& exc
     _sos_constraints.emplace_back(exclusive_variables);
 }
 
+std::vector<SOCVariable::Reference> SOCModel::splice(SOCModel const& fragment) {
+    helpers::exception_check(fragment.objectives().empty(), "Objectives of fragments are not spliced!");
+    std::vector<SOCVariable::Reference> new_variables;
+    new_variables.reserve(fragment.variables().size());
+    for (auto const& var: fragment.variables()) {
+        new_variables.emplace_back(add_variable(var.name(), var.lb(), var.ub(), var.type()));
+    }
+    auto const translate = [&](SOCVariable::Reference const& var) {
+        SOCVariable::Index const id = var;
+        return &id.owner() == &fragment ? new_variables[var.raw_id()] : var;
+    };
+    auto const translate_affine = [&](AffineExpression<SOCVariable::Reference> const& affine) {
+        AffineExpression<SOCVariable::Reference> translated(affine.constant());
+        for (auto const& svar: affine.linear().scaled_variables()) {
+            translated += svar.scale() * translate(svar.variable());
+        }
+        return translated;
+    };
+    for (auto const& constr: fragment.soc_constraints()) {
+        auto const& expression = constr.soc_expression();
+        if (expression.is_affine()) {
+            add_constraint({constr.sense(), translate_affine(expression.affine()), constr.name()});
+            continue;
+        }
+        std::vector<AffineExpression<SOCVariable::Reference>> normed_vector;
+        for (auto const& entry: expression.normed_vector().normed_vector()) {
+            normed_vector.emplace_back(translate_affine(entry));
+        }
+        add_constraint({constr.sense(),
+                        SOCExpression<SOCVariable>(
+                                NormedAffineVector<SOCVariable>(expression.normed_vector().norm_type(), normed_vector),
+                                translate_affine(expression.affine())),
+                        constr.name()});
+    }
+    for (auto const& sos: fragment.sos_constraints()) {
+        std::vector<SOCVariable::Reference> exclusive_variables;
+        for (auto const& var: sos.exclusive_variables()) {
+            exclusive_variables.emplace_back(translate(var));
+        }
+        add_sos_constraint(exclusive_variables);
+    }
+    return new_variables;
+}
+
+void SOCModel::set_coefficients(size_t const constraint_number,
+                                std::vector<std::pair<SOCVariable::Reference, double>> const& coefficients) {
+    auto& constraint = _soc_constraints.at(constraint_number);
+    helpers::exception_check(constraint.soc_expression().is_affine(),
+                             "Coefficients can only be changed in affine constraints, not in " + constraint.name());
+    std::unordered_set<size_t> changed_variables;
+    LinearExpression<SOCVariable::Reference> linear;
+    for (auto const& [variable, value]: coefficients) {
+        changed_variables.insert(variable.raw_id());
+        linear += ScaledVariable<SOCVariable::Reference>(value, variable);
+        _coefficient_changes.push_back({constraint_number, variable, value});
+    }
+    // the old terms of changed variables are dropped, so that each of them appears exactly once
+    auto const& affine = constraint.soc_expression().affine();
+    for (auto const& svar: affine.linear().scaled_variables()) {
+        if (not changed_variables.contains(svar.variable().raw_id())) {
+            linear += svar;
+        }
+    }
+    constraint = SOCConstraint<SOCVariable>(constraint.sense(),
+                                            AffineExpression<SOCVariable::Reference>(affine.constant(), linear),
+                                            constraint.name());
+    invalidate_dual();
+}
+
+std::vector<SOCModel::CoefficientChange> const& SOCModel::coefficient_changes() const {
+    return _coefficient_changes;
+}
+
+void SOCModel::clear_coefficient_changes() {
+    _coefficient_changes.clear();
+}
+
+void SOCModel::set_start_values(std::vector<std::pair<SOCVariable::Reference, double>> const& start_values) {
+    for (auto const& [variable, value]: start_values) {
+        helpers::exception_check(variable.raw_id() < variables().size(), "Start value of an unknown variable!");
+        _start_values.push_back({variable, value});
+    }
+}
+
+std::vector<SOCModel::StartValue> const& SOCModel::start_values() const {
+    return _start_values;
+}
+
+void SOCModel::clear_start_values() {
+    _start_values.clear();
+}
+
 std::string const&
 SOCModel::name() const {
     return _name;
@@ -96,24 +193,28 @@ SOCModel::name() const {
 
 std::string
 SOCModel::full_string() const {
-    std::string s = name();
+    // streamed, since repeated string concatenation is quadratic for large models
+    std::ostringstream s;
+    s << name();
     size_t obj_num = 0;
     for (auto const& obj: objectives()) {
         ++obj_num;
-        s += "\nObjective " + std::to_string(obj_num) + ": " + obj.to_string();
+        s << "\nObjective " << obj_num << ": " << obj.to_string();
     }
     for (auto const& constr: soc_constraints()) {
-        s += "\n" + constr.to_string() +
-             (constr.has_dual_value() ? (" (" + std::to_string(constr.dual_value()) + ")") : "");
+        s << "\n" << constr.to_string();
+        if (constr.has_dual_value())
+            s << " (" << std::to_string(constr.dual_value()) << ")";
     }
     for (auto const& constr: sos_constraints()) {
-        s += "\n" + constr.to_string();
+        s << "\n" << constr.to_string();
     }
     for (auto const& var: objects()) {
-        s += "\n" + std::to_string(var.lb()) + " <= " + var.name() + " <= " + std::to_string(var.ub())
-             + (var.has_solution() ? (" (" + std::to_string(var.solution()) + ")") : "");
+        s << "\n" << std::to_string(var.lb()) << " <= " << var.name() << " <= " << std::to_string(var.ub());
+        if (var.has_solution())
+            s << " (" << std::to_string(var.solution()) << ")";
     }
-    return s;
+    return s.str();
 }
 
 void SOCModel::compute_dual() {
@@ -223,6 +324,14 @@ void SOCModel::set_dual_soc_constraint_values(std::vector<double> const& values)
     }
 }
 
+void SOCModel::set_reduced_costs(std::vector<double> const& reduced_costs) {
+    helpers::exception_check(reduced_costs.size() == variables().size(),
+                             "Need to set exactly one reduced cost for each variable");
+    for (auto& var: non_const_objects()) {
+        var.set_reduced_cost(reduced_costs.at(var.id().raw_id()));
+    }
+}
+
 void SOCModel::invalidate_solution() {
     for(auto & var : non_const_objects()){
         var.invalidate_solution();
@@ -8,9 +8,6 @@
 #include "basic_model_objects/SOSConstraint.h"
 #include <memory>
 
-class GRBModel;
-class GRBEnv;
-
 namespace robust_model {
 
 class SOCModel : public helpers::IndexedObjectOwner<SOCVariable> {
@@ -18,6 +15,17 @@ public:
     using SOCVariableReference = VariableReference<SOCVariable>;
     using Constraint = SOCConstraint<SOCVariable>;
     using Objective = ObjectiveBase<AffineExpression<SOCVariable::Reference>>;
+
+    struct CoefficientChange {
+        size_t constraint_number;
+        SOCVariable::Reference variable;
+        double value;
+    };
+
+    struct StartValue {
+        SOCVariable::Reference variable;
+        double value;
+    };
 public:
     explicit SOCModel(std::string  name);
 
@@ -35,6 +43,28 @@ public:
 
     void add_sos_constraint(std::vector<SOCVariable::Reference> const& exclusive_variables);
 
+    // appends the variables, constraints and sos constraints of a fragment, whose constraints may also use
+    // variables of this model; returns the new variable of each fragment variable
+    std::vector<SOCVariable::Reference> splice(SOCModel const& fragment);
+
+    // changes coefficients of variables in an affine constraint in place
+    // the changes are logged, so that solvers holding a transferred model can apply them on their next update
+    void set_coefficients(size_t constraint_number,
+                          std::vector<std::pair<SOCVariable::Reference, double>> const& coefficients);
+
+    std::vector<CoefficientChange> const& coefficient_changes() const;
+
+    // called by the solver holding the transferred model, once it applied the logged changes
+    void clear_coefficient_changes();
+
+    // start values of some variables for the next solve, the solver holding the transferred model passes them on
+    // to its backend and clears them
+    void set_start_values(std::vector<std::pair<SOCVariable::Reference, double>> const& start_values);
+
+    std::vector<StartValue> const& start_values() const;
+
+    void clear_start_values();
+
     std::vector<SOCVariable> const& variables() const;
 
     std::vector<SOCConstraint<SOCVariable>> const& soc_constraints() const;
@@ -47,6 +77,9 @@ public:
 
     void clear_and_set_objective(Objective const& objective);
 
+    // counts the calls of clear_and_set_objective, so that solvers notice replaced objectives
+    size_t objective_revision() const;
+
     void add_objective(Objective const& objective);
 
     bool is_multi_objective() const;
@@ -71,6 +104,8 @@ public:
 
     void set_dual_soc_constraint_values(std::vector<double> const& values);
 
+    void set_reduced_costs(std::vector<double> const& reduced_costs);
+
     void invalidate_solution();
     
     void compute_dual();
@@ -104,8 +139,11 @@ private:
 private:
     std::string const _name;
     std::vector<Objective> _objectives;
+    size_t _objective_revision = 0;
     std::vector<SOCConstraint<SOCVariable>> _soc_constraints;
     std::vector<SOSConstraint> _sos_constraints;
+    std::vector<CoefficientChange> _coefficient_changes;
+    std::vector<StartValue> _start_values;
     std::unique_ptr<SOCModel> _dual;
 };
 
@@ -0,0 +1,515 @@
+#include "SOCModelWriter.h"
+#include "SOCConicForm.h"
+#include "../helpers/GzipOutputStream.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace robust_model {
+
+SOCModelWriter::SOCModelWriter(SOCModel const& model) : _model(model) {}
+
+void SOCModelWriter::write(std::ostream& stream, Format const format) const {
+    helpers::exception_check(not _model.is_multi_objective(),
+                             "Writing is only available for single objectives, " + _model.name() + " has several!");
+    auto const precision = stream.precision(std::numeric_limits<double>::max_digits10);
+    switch (format) {
+        case Format::MPS:
+            write_mps(stream);
+            break;
+        case Format::LP:
+            write_lp(stream);
+            break;
+        case Format::CBF:
+            write_cbf(stream);
+            break;
+    }
+    stream.precision(precision);
+    stream.flush();
+    helpers::exception_check(stream.good(), "Writing " + _model.name() + " failed!");
+}
+
+void SOCModelWriter::write(std::string const& file_name) const {
+    auto const file_format = format(file_name);
+    if (compressed(file_name)) {
+#ifdef ROBUSTOPTIMIZATION_WITH_ZLIB
+        helpers::GzipOutputStream stream(file_name);
+        write(stream, file_format);
+#else
+        helpers::exception_throw("Writing compressed files needs zlib, which was not found: " + file_name);
+#endif
+        return;
+    }
+    std::vector<char> buffer(1 << 16);
+    std::ofstream stream;
+    stream.rdbuf()->pubsetbuf(buffer.data(), std::streamsize(buffer.size()));
+    stream.open(file_name);
+    helpers::exception_check(stream.is_open(), "Could not open " + file_name + " for writing!");
+    write(stream, file_format);
+}
+
+SOCModelWriter::Format SOCModelWriter::format(std::string const& file_name) {
+    std::string name = file_name;
+    if (compressed(name)) {
+        name.resize(name.size() - 3);
+    }
+    auto const has_extension = [&](std::string const& extension) {
+        return name.size() > extension.size() and
+               name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+    };
+    if (has_extension(".mps"))
+        return Format::MPS;
+    if (has_extension(".lp"))
+        return Format::LP;
+    helpers::exception_check(has_extension(".cbf"), "Unknown model file extension: " + file_name);
+    return Format::CBF;
+}
+
+bool SOCModelWriter::compressed(std::string const& file_name) {
+    return file_name.size() > 3 and file_name.compare(file_name.size() - 3, 3, ".gz") == 0;
+}
+
+SOCModelWriter::AlgebraicForm SOCModelWriter::column_form() const {
+    AlgebraicForm form;
+    for (auto const& var: _model.variables()) {
+        form.lbs.emplace_back(var.lb());
+        form.ubs.emplace_back(var.ub());
+        form.types.emplace_back(var.type());
+    }
+    form.objective.assign(_model.variables().size(), 0.);
+    form.objective_constant = _model.objective().expression().constant();
+    for (auto const& svar: _model.objective().expression().linear().scaled_variables()) {
+        form.objective[svar.variable().raw_id()] += svar.scale();
+    }
+    return form;
+}
+
+SOCModelWriter::AlgebraicForm SOCModelWriter::algebraic_form() const {
+    auto form = column_form();
+    for (auto const& constr: _model.soc_constraints()) {
+        add_constraint(form, constr);
+    }
+    return form;
+}
+
+void SOCModelWriter::clear_rows(AlgebraicForm& form) {
+    form.first_row += form.rhs.size();
+    form.first_cone += form.cones.size();
+    form.row_starts = {0};
+    form.column_indices.clear();
+    form.values.clear();
+    form.senses.clear();
+    form.rhs.clear();
+    form.cones.clear();
+}
+
+void SOCModelWriter::add_constraint(AlgebraicForm& form, SOCModel::Constraint const& constr) {
+    auto const& affine = constr.soc_expression().affine();
+    Terms terms;
+    if (constr.soc_expression().is_affine()) {
+        double const constant = append(terms, affine, 1.);
+        add_row(form, terms, constr.sense(), constant);
+        return;
+    }
+    helpers::exception_check(constr.sense() == ConstraintSense::LEQ,
+                             "Normed constraint " + constr.name() + " is not convex!");
+    auto const& normed_vector = constr.soc_expression().normed_vector().normed_vector();
+    switch (constr.soc_expression().normed_vector().norm_type()) {
+        case VectorNormType::Two: {
+            // t = -(c^T x + d) and y_k = a_k^T x + b_k with ||y|| <= t
+            std::vector<int> cone;
+            cone.emplace_back(add_auxiliary_column(form, 0., NO_VARIABLE_UB));
+            terms.emplace_back(cone.front(), 1.);
+            double constant = append(terms, affine, 1.);
+            add_row(form, terms, ConstraintSense::EQ, constant);
+            for (auto const& entry: normed_vector) {
+                cone.emplace_back(add_auxiliary_column(form, NO_VARIABLE_LB, NO_VARIABLE_UB));
+                terms.emplace_back(cone.back(), -1.);
+                constant = append(terms, entry, 1.);
+                add_row(form, terms, ConstraintSense::EQ, constant);
+            }
+            form.cones.emplace_back(std::move(cone));
+            return;
+        }
+        case VectorNormType::One: {
+            Terms sum_terms;
+            for (auto const& entry: normed_vector) {
+                int const abs = add_auxiliary_column(form, 0., NO_VARIABLE_UB);
+                for (double const sign: {1., -1.}) {
+                    double const constant = append(terms, entry, sign);
+                    terms.emplace_back(abs, -1.);
+                    add_row(form, terms, ConstraintSense::LEQ, constant);
+                }
+                sum_terms.emplace_back(abs, 1.);
+            }
+            double const constant = append(sum_terms, affine, 1.);
+            add_row(form, sum_terms, ConstraintSense::LEQ, constant);
+            return;
+        }
+        case VectorNormType::Max: {
+            for (auto const& entry: normed_vector) {
+                for (double const sign: {1., -1.}) {
+                    double const constant = append(terms, entry, sign) + append(terms, affine, 1.);
+                    add_row(form, terms, ConstraintSense::LEQ, constant);
+                }
+            }
+            return;
+        }
+    }
+}
+
+int SOCModelWriter::add_auxiliary_column(AlgebraicForm& form, double const lb, double const ub) {
+    form.lbs.emplace_back(lb);
+    form.ubs.emplace_back(ub);
+    form.types.emplace_back(VariableType::Continuous);
+    form.objective.emplace_back(0.);
+    return int(form.lbs.size() - 1);
+}
+
+double SOCModelWriter::append(Terms& terms, AffineExpression<SOCVariable::Reference> const& affine, double scale) {
+    for (auto const& svar: affine.linear().scaled_variables()) {
+        terms.emplace_back(int(svar.variable().raw_id()), scale * svar.scale());
+    }
+    return scale * affine.constant();
+}
+
+void SOCModelWriter::add_row(AlgebraicForm& form, Terms& terms, ConstraintSense const sense, double const constant) {
+    std::sort(terms.begin(), terms.end(),
+              [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+    for (auto const& [column, value]: terms) {
+        if (form.row_starts.back() < int(form.column_indices.size()) and form.column_indices.back() == column) {
+            form.values.back() += value;
+            continue;
+        }
+        form.column_indices.emplace_back(column);
+        form.values.emplace_back(value);
+    }
+    terms.clear();
+    form.row_starts.emplace_back(int(form.column_indices.size()));
+    form.senses.emplace_back(sense);
+    // 0. - constant avoids writing -0
+    form.rhs.emplace_back(0. - constant);
+}
+
+void SOCModelWriter::write_mps(std::ostream& stream) const {
+    auto const form = algebraic_form();
+    size_t const num_rows = form.rhs.size();
+    size_t const num_columns = form.lbs.size();
+
+    // the columns section is written column wise
+    std::vector<int> column_starts(num_columns + 1, 0);
+    for (auto const column: form.column_indices) {
+        ++column_starts[column + 1];
+    }
+    for (size_t j = 0; j < num_columns; ++j) {
+        column_starts[j + 1] += column_starts[j];
+    }
+    std::vector<int> row_indices(form.column_indices.size());
+    std::vector<double> column_values(form.values.size());
+    std::vector<int> next(column_starts.begin(), column_starts.end() - 1);
+    for (size_t i = 0; i < num_rows; ++i) {
+        for (int k = form.row_starts[i]; k < form.row_starts[i + 1]; ++k) {
+            int const position = next[form.column_indices[k]]++;
+            row_indices[position] = int(i);
+            column_values[position] = form.values[k];
+        }
+    }
+
+    stream << "NAME " << model_name() << "\n";
+    if (_model.objective().sense() == ObjectiveSense::MAX) {
+        stream << "OBJSENSE\n    MAX\n";
+    }
+    stream << "ROWS\n N  obj\n";
+    for (size_t i = 0; i < num_rows; ++i) {
+        switch (form.senses[i]) {
+            case ConstraintSense::LEQ:
+                stream << " L  c" << i << "\n";
+                break;
+            case ConstraintSense::GEQ:
+                stream << " G  c" << i << "\n";
+                break;
+            case ConstraintSense::EQ:
+                stream << " E  c" << i << "\n";
+                break;
+        }
+    }
+    for (size_t k = 0; k < form.cones.size(); ++k) {
+        stream << " L  q" << k << "\n";
+    }
+
+    stream << "COLUMNS\n";
+    bool integer_block = false;
+    for (size_t j = 0; j < num_columns; ++j) {
+        bool const integer = form.types[j] != VariableType::Continuous;
+        if (integer != integer_block) {
+            stream << "    MARKER    'MARKER'    " << (integer ? "'INTORG'" : "'INTEND'") << "\n";
+            integer_block = integer;
+        }
+        // every column is listed, even without any coefficient
+        if (form.objective[j] != 0 or column_starts[j] == column_starts[j + 1]) {
+            stream << "    x" << j << " obj " << form.objective[j] << "\n";
+        }
+        for (int k = column_starts[j]; k < column_starts[j + 1]; ++k) {
+            stream << "    x" << j << " c" << row_indices[k] << " " << column_values[k] << "\n";
+        }
+    }
+    if (integer_block) {
+        stream << "    MARKER    'MARKER'    'INTEND'\n";
+    }
+
+    stream << "RHS\n";
+    if (form.objective_constant != 0) {
+        stream << "    rhs obj " << -form.objective_constant << "\n";
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (form.rhs[i] != 0) {
+            stream << "    rhs c" << i << " " << form.rhs[i] << "\n";
+        }
+    }
+
+    stream << "BOUNDS\n";
+    for (size_t j = 0; j < num_columns; ++j) {
+        double const lb = form.lbs[j];
+        double const ub = form.ubs[j];
+        if (form.types[j] == VariableType::Binary and lb == 0 and ub == 1) {
+            stream << " BV bnd x" << j << "\n";
+        } else if (lb == ub) {
+            stream << " FX bnd x" << j << " " << lb << "\n";
+        } else if (lb == NO_VARIABLE_LB and ub == NO_VARIABLE_UB) {
+            stream << " FR bnd x" << j << "\n";
+        } else {
+            if (lb == NO_VARIABLE_LB) {
+                stream << " MI bnd x" << j << "\n";
+            } else if (lb != 0) {
+                stream << " LO bnd x" << j << " " << lb << "\n";
+            }
+            if (ub != NO_VARIABLE_UB) {
+                stream << " UP bnd x" << j << " " << ub << "\n";
+            }
+        }
+    }
+
+    if (not _model.sos_constraints().empty()) {
+        stream << "SOS\n";
+        for (size_t k = 0; k < _model.sos_constraints().size(); ++k) {
+            stream << " S1 SOS s" << k << " 1\n";
+            size_t weight = 0;
+            for (auto const& var: _model.sos_constraints()[k].exclusive_variables()) {
+                stream << "    x" << var.raw_id() << ":" << ++weight << "\n";
+            }
+        }
+    }
+
+    for (size_t k = 0; k < form.cones.size(); ++k) {
+        stream << "QCMATRIX   q" << k << "\n";
+        auto const& cone = form.cones[k];
+        for (size_t l = 1; l < cone.size(); ++l) {
+            stream << "    x" << cone[l] << " x" << cone[l] << " 1\n";
+        }
+        stream << "    x" << cone.front() << " x" << cone.front() << " -1\n";
+    }
+    stream << "ENDATA\n";
+}
+
+void SOCModelWriter::write_lp(std::ostream& stream) const {
+    static const size_t terms_per_line = 8;
+    // the auxiliary columns are added, while the constraints are written
+    auto form = column_form();
+    auto const write_term = [&](double value, int column, size_t position) {
+        if (position > 0 and position % terms_per_line == 0) {
+            stream << "\n   ";
+        }
+        stream << (value < 0 ? " - " : " + ") << std::abs(value) << " x" << column;
+    };
+    auto const write_bound = [&](double value) {
+        if (value == NO_VARIABLE_LB) {
+            stream << "-inf";
+        } else if (value == NO_VARIABLE_UB) {
+            stream << "+inf";
+        } else {
+            stream << value;
+        }
+    };
+
+    stream << "\\ " << model_name() << "\n";
+    stream << (_model.objective().sense() == ObjectiveSense::MAX ? "Maximize" : "Minimize") << "\n obj:";
+    size_t position = 0;
+    for (size_t j = 0; j < form.objective.size(); ++j) {
+        if (form.objective[j] != 0) {
+            write_term(form.objective[j], int(j), position++);
+        }
+    }
+    if (form.objective_constant != 0 or position == 0) {
+        stream << (form.objective_constant < 0 ? " - " : " + ") << std::abs(form.objective_constant);
+    }
+
+    stream << "\nSubject To\n";
+    for (auto const& constr: _model.soc_constraints()) {
+        add_constraint(form, constr);
+        for (size_t i = 0; i < form.rhs.size(); ++i) {
+            stream << " c" << form.first_row + i << ":";
+            for (int k = form.row_starts[i]; k < form.row_starts[i + 1]; ++k) {
+                write_term(form.values[k], form.column_indices[k], size_t(k - form.row_starts[i]));
+            }
+            if (form.row_starts[i] == form.row_starts[i + 1]) {
+                stream << " 0";
+            }
+            switch (form.senses[i]) {
+                case ConstraintSense::LEQ:
+                    stream << " <= ";
+                    break;
+                case ConstraintSense::GEQ:
+                    stream << " >= ";
+                    break;
+                case ConstraintSense::EQ:
+                    stream << " = ";
+                    break;
+            }
+            stream << form.rhs[i] << "\n";
+        }
+        for (size_t k = 0; k < form.cones.size(); ++k) {
+            auto const& cone = form.cones[k];
+            stream << " q" << form.first_cone + k << ": [";
+            for (size_t l = 1; l < cone.size(); ++l) {
+                stream << (l > 1 ? " + x" : " x") << cone[l] << " ^2";
+            }
+            stream << " - x" << cone.front() << " ^2 ] <= 0\n";
+        }
+        clear_rows(form);
+    }
+
+    size_t const num_columns = form.lbs.size();
+    stream << "Bounds\n";
+    for (size_t j = 0; j < num_columns; ++j) {
+        double const lb = form.lbs[j];
+        double const ub = form.ubs[j];
+        if ((lb == 0 and ub == NO_VARIABLE_UB) or (form.types[j] == VariableType::Binary and lb == 0 and ub == 1)) {
+            continue;
+        }
+        if (lb == ub) {
+            stream << " x" << j << " = " << lb << "\n";
+        } else if (lb == NO_VARIABLE_LB and ub == NO_VARIABLE_UB) {
+            stream << " x" << j << " free\n";
+        } else {
+            stream << " ";
+            write_bound(lb);
+            stream << " <= x" << j << " <= ";
+            write_bound(ub);
+            stream << "\n";
+        }
+    }
+
+    for (auto const type: {VariableType::Integer, VariableType::Binary}) {
+        if (std::find(form.types.begin(), form.types.end(), type) == form.types.end()) {
+            continue;
+        }
+        stream << (type == VariableType::Integer ? "Generals\n" : "Binaries\n");
+        for (size_t j = 0; j < num_columns; ++j) {
+            if (form.types[j] == type) {
+                stream << " x" << j << "\n";
+            }
+        }
+    }
+
+    if (not _model.sos_constraints().empty()) {
+        stream << "SOS\n";
+        for (size_t k = 0; k < _model.sos_constraints().size(); ++k) {
+            stream << " s" << k << ": S1::";
+            size_t weight = 0;
+            for (auto const& var: _model.sos_constraints()[k].exclusive_variables()) {
+                stream << " x" << var.raw_id() << ":" << ++weight;
+            }
+            stream << "\n";
+        }
+    }
+    stream << "End\n";
+}
+
+void SOCModelWriter::write_cbf(std::ostream& stream) const {
+    helpers::exception_check(_model.sos_constraints().empty(),
+                             "The CBF format does not support the sos constraints of " + _model.name() + "!");
+    // the conic form is  b - A x in K, which CBF writes as  (-A) x + b in K
+    SOCConicForm const form(_model);
+    size_t const num_rows = form.num_rows();
+    size_t const num_columns = form.num_columns();
+    double const objective_sign = form.maximize() ? -1. : 1.;
+
+    stream << "# " << model_name() << "\n";
+    stream << "VER\n3\n\n";
+    stream << "OBJSENSE\n" << (form.maximize() ? "MAX" : "MIN") << "\n\n";
+    stream << "VAR\n" << num_columns << " 1\nF " << num_columns << "\n\n";
+
+    size_t num_integers = 0;
+    for (auto const& var: _model.variables()) {
+        num_integers += var.type() != VariableType::Continuous;
+    }
+    if (num_integers > 0) {
+        stream << "INT\n" << num_integers << "\n";
+        for (auto const& var: _model.variables()) {
+            if (var.type() != VariableType::Continuous) {
+                stream << var.id().raw_id() << "\n";
+            }
+        }
+        stream << "\n";
+    }
+
+    size_t const num_cones = (form.num_zero_rows() > 0) + (form.num_nonnegative_rows() > 0)
+                             + form.second_order_cone_sizes().size();
+    stream << "CON\n" << num_rows << " " << num_cones << "\n";
+    if (form.num_zero_rows() > 0) {
+        stream << "L= " << form.num_zero_rows() << "\n";
+    }
+    if (form.num_nonnegative_rows() > 0) {
+        stream << "L+ " << form.num_nonnegative_rows() << "\n";
+    }
+    for (auto const size: form.second_order_cone_sizes()) {
+        stream << "Q " << size << "\n";
+    }
+    stream << "\n";
+
+    size_t const num_objective_nonzeros = num_columns - std::count(form.objective().begin(),
+                                                                   form.objective().end(), 0.);
+    if (num_objective_nonzeros > 0) {
+        stream << "OBJACOORD\n" << num_objective_nonzeros << "\n";
+        for (size_t j = 0; j < num_columns; ++j) {
+            if (form.objective()[j] != 0) {
+                stream << j << " " << objective_sign * form.objective()[j] << "\n";
+            }
+        }
+        stream << "\n";
+    }
+    if (form.objective_constant() != 0) {
+        stream << "OBJBCOORD\n" << form.objective_constant() << "\n\n";
+    }
+
+    if (not form.values().empty()) {
+        stream << "ACOORD\n" << form.values().size() << "\n";
+        for (size_t i = 0; i < num_rows; ++i) {
+            for (int k = form.row_starts()[i]; k < form.row_starts()[i + 1]; ++k) {
+                stream << i << " " << form.column_indices()[k] << " " << -form.values()[k] << "\n";
+            }
+        }
+        stream << "\n";
+    }
+    size_t const num_rhs_nonzeros = num_rows - std::count(form.rhs().begin(), form.rhs().end(), 0.);
+    if (num_rhs_nonzeros > 0) {
+        stream << "BCOORD\n" << num_rhs_nonzeros << "\n";
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (form.rhs()[i] != 0) {
+                stream << i << " " << form.rhs()[i] << "\n";
+            }
+        }
+    }
+}
+
+std::string SOCModelWriter::model_name() const {
+    std::string name = _model.name();
+    std::replace_if(name.begin(), name.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); }, '_');
+    return name.empty() ? "SOCModel" : name;
+}
+
+}
@@ -0,0 +1,98 @@
+#ifndef ROBUSTOPTIMIZATION_SOCMODELWRITER_H
+#define ROBUSTOPTIMIZATION_SOCMODELWRITER_H
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SOCModel.h"
+
+namespace robust_model {
+
+// Streams a SOCModel in the free MPS, CPLEX LP or CBF (conic benchmark) format.
+// Variables are named x<j> and rows c<i> by their index, norm constraints are written with auxiliary variables
+// behind the model variables. MPS and LP write two norms as quadratic cones  sum y_k^2 <= t^2, t >= 0,
+// CBF uses its native quadratic cones, but does not support sos constraints.
+// Multi objective models are rejected by all formats.
+// LP is written constraint by constraint, MPS lists the matrix column wise and CBF orders the rows by cone,
+// so these two hold the whole matrix before writing it.
+class SOCModelWriter {
+public:
+    enum class Format {
+        MPS,
+        LP,
+        CBF
+    };
+
+public:
+    explicit SOCModelWriter(SOCModel const& model);
+
+    void write(std::ostream& stream, Format format) const;
+
+    // the format is taken from the extension .mps, .lp or .cbf, a further .gz compresses the file
+    void write(std::string const& file_name) const;
+
+    static Format format(std::string const& file_name);
+
+    static bool compressed(std::string const& file_name);
+
+private:
+    // model with linear rows and quadratic cones only, the columns are the model variables followed by
+    // the auxiliary variables
+    struct AlgebraicForm {
+        std::vector<double> lbs;
+        std::vector<double> ubs;
+        std::vector<VariableType> types;
+        std::vector<double> objective;
+        double objective_constant = 0;
+
+        std::vector<int> row_starts = {0};
+        std::vector<int> column_indices;
+        std::vector<double> values;
+        std::vector<ConstraintSense> senses;
+        std::vector<double> rhs;
+
+        // sum_{k>0} x[cone[k]]^2 <= x[cone[0]]^2
+        std::vector<std::vector<int>> cones;
+
+        // number of rows and cones already written and cleared from the form
+        size_t first_row = 0;
+        size_t first_cone = 0;
+    };
+
+    using Terms = std::vector<std::pair<int, double>>;
+
+    // the columns and the objective without any rows
+    AlgebraicForm column_form() const;
+
+    AlgebraicForm algebraic_form() const;
+
+    // drops the rows and cones after they were written, the columns are kept
+    static void clear_rows(AlgebraicForm& form);
+
+    static void add_constraint(AlgebraicForm& form, SOCModel::Constraint const& constr);
+
+    static int add_auxiliary_column(AlgebraicForm& form, double lb, double ub);
+
+    // appends scale * affine to the terms and returns the scaled constant
+    static double append(Terms& terms, AffineExpression<SOCVariable::Reference> const& affine, double scale);
+
+    // adds the row  terms^T x + constant (sense) 0, duplicate columns are merged
+    static void add_row(AlgebraicForm& form, Terms& terms, ConstraintSense sense, double constant);
+
+    void write_mps(std::ostream& stream) const;
+
+    void write_lp(std::ostream& stream) const;
+
+    void write_cbf(std::ostream& stream) const;
+
+    std::string model_name() const;
+
+private:
+    SOCModel const& _model;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_SOCMODELWRITER_H
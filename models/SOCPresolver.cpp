@@ -0,0 +1,460 @@
+#include "SOCPresolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+
+namespace robust_model {
+
+std::string SOCPresolver::Statistics::to_string() const {
+    return "Presolve removed " + std::to_string(original_variables - reduced_variables) + " of "
+           + std::to_string(original_variables) + " variables and "
+           + std::to_string(original_constraints - reduced_constraints) + " of "
+           + std::to_string(original_constraints) + " constraints (empty rows: " + std::to_string(empty_rows)
+           + ", singleton rows: " + std::to_string(singleton_rows)
+           + ", fixed variables: " + std::to_string(fixed_variables)
+           + ", parallel rows: " + std::to_string(parallel_rows) + ")";
+}
+
+SOCPresolver::SOCPresolver(SOCModel const& model) :
+        _reduced_variables(model.variables().size()),
+        _reduced_constraints(model.soc_constraints().size()),
+        _fixed(model.variables().size(), false),
+        _fixed_values(model.variables().size(), 0.),
+        _parallel_representatives(model.soc_constraints().size(), false),
+        _columns(model.variables().size()),
+        _objective_coefficients(model.variables().size(), 0.) {
+    _statistics.original_variables = model.variables().size();
+    _statistics.original_constraints = model.soc_constraints().size();
+
+    std::vector<Row> rows;
+    rows.reserve(model.soc_constraints().size());
+    for (size_t i = 0; i < model.soc_constraints().size(); ++i) {
+        rows.emplace_back(affine_row(model.soc_constraints()[i], i));
+    }
+
+    fix_variables(model, rows);
+    merge_parallel_rows(rows);
+    build_reduced_model(model, rows);
+}
+
+SOCModel const& SOCPresolver::reduced_model() const {
+    return *_reduced_model;
+}
+
+SOCModel& SOCPresolver::reduced_model() {
+    return *_reduced_model;
+}
+
+SOCPresolver::Statistics const& SOCPresolver::statistics() const {
+    return _statistics;
+}
+
+bool SOCPresolver::update(SOCModel const& model) {
+    for (size_t j = _fixed.size(); j < model.variables().size(); ++j) {
+        _reduced_variables.emplace_back();
+        _fixed.push_back(false);
+        _fixed_values.push_back(0.);
+        _columns.emplace_back();
+        _objective_coefficients.push_back(0.);
+        add_reduced_variable(model.variables()[j]);
+    }
+
+    size_t const num_presolved_constraints = _reduced_constraints.size();
+    // the last change of a coefficient counts, changes are collected per reduced row
+    std::map<size_t, std::map<size_t, double>> reduced_changes;
+    for (auto const& change: model.coefficient_changes()) {
+        size_t const i = change.constraint_number;
+        size_t const j = change.variable.raw_id();
+        // added constraints already contain the change
+        if (i >= num_presolved_constraints) {
+            continue;
+        }
+        if (not _reduced_constraints[i].has_value() or _fixed[j] or _parallel_representatives[i]) {
+            return false;
+        }
+        auto const entry = std::find_if(_columns[j].begin(), _columns[j].end(),
+                                        [i](auto const& column_entry) { return column_entry.first == i; });
+        if (entry == _columns[j].end()) {
+            _columns[j].emplace_back(i, change.value);
+        } else {
+            entry->second = change.value;
+        }
+        reduced_changes[_reduced_constraints[i].value()][_reduced_variables[j].value()] = change.value;
+    }
+    for (auto const& [i, changes]: reduced_changes) {
+        std::vector<std::pair<SOCVariable::Reference, double>> coefficients;
+        for (auto const& [j, value]: changes) {
+            coefficients.emplace_back(reduced_model().variables()[j].reference(), value);
+        }
+        reduced_model().set_coefficients(i, coefficients);
+    }
+
+    for (size_t i = num_presolved_constraints; i < model.soc_constraints().size(); ++i) {
+        _reduced_constraints.emplace_back();
+        _parallel_representatives.push_back(false);
+        affine_row(model.soc_constraints()[i], i);
+        add_reduced_constraint(model.soc_constraints()[i], i);
+    }
+    for (size_t k = reduced_model().sos_constraints().size(); k < model.sos_constraints().size(); ++k) {
+        auto const& sos = model.sos_constraints()[k];
+        if (std::any_of(sos.exclusive_variables().begin(), sos.exclusive_variables().end(),
+                        [this](auto const& var) { return _fixed[var.raw_id()]; })) {
+            return false;
+        }
+        add_reduced_sos_constraint(sos);
+    }
+    if (model.objective_revision() != _objective_revision
+        or model.objectives().size() != reduced_model().objectives().size()) {
+        set_reduced_objectives(model);
+    }
+    add_reduced_start_values(model);
+
+    _statistics.original_variables = model.variables().size();
+    _statistics.original_constraints = model.soc_constraints().size();
+    _statistics.reduced_variables = reduced_model().variables().size();
+    _statistics.reduced_constraints = reduced_model().soc_constraints().size();
+    return true;
+}
+
+SOCPresolver::Row SOCPresolver::affine_row(SOCModel::Constraint const& constr, size_t const constraint_number) {
+    Row row;
+    if (not constr.soc_expression().is_affine()) {
+        row.affine = false;
+        return row;
+    }
+    auto const& affine = constr.soc_expression().affine();
+    std::map<size_t, double> coefficients;
+    for (auto const& svar: affine.linear().scaled_variables()) {
+        coefficients[svar.variable().raw_id()] += svar.scale();
+    }
+    for (auto const& [j, coefficient]: coefficients) {
+        if (coefficient != 0) {
+            row.entries.emplace_back(j, coefficient);
+            _columns[j].emplace_back(constraint_number, coefficient);
+        }
+    }
+    row.constant = affine.constant();
+    row.sense = constr.sense();
+    row.active_entries = row.entries.size();
+    return row;
+}
+
+void SOCPresolver::fix_variables(SOCModel const& model, std::vector<Row>& rows) {
+    std::vector<bool> sos_variables(model.variables().size(), false);
+    for (auto const& sos: model.sos_constraints()) {
+        for (auto const& var: sos.exclusive_variables()) {
+            sos_variables[var.raw_id()] = true;
+        }
+    }
+    std::vector<size_t> changed_rows;
+    for (auto const& var: model.variables()) {
+        size_t const j = var.id().raw_id();
+        if (not sos_variables[j] and var.lb() == var.ub() and std::isfinite(var.lb())) {
+            fix_variable(j, var.lb(), rows, changed_rows);
+            ++_statistics.fixed_variables;
+        }
+    }
+    changed_rows.resize(rows.size());
+    std::iota(changed_rows.begin(), changed_rows.end(), 0);
+    // fixing a variable may turn further rows into empty or singleton rows
+    while (not changed_rows.empty()) {
+        auto& row = rows[changed_rows.back()];
+        size_t const i = changed_rows.back();
+        changed_rows.pop_back();
+        if (not row.affine or row.removed) {
+            continue;
+        }
+        if (row.active_entries == 0) {
+            if (satisfied(row.constant, row.sense)) {
+                row.removed = true;
+                ++_statistics.empty_rows;
+            }
+            continue;
+        }
+        if (row.active_entries != 1 or row.sense != ConstraintSense::EQ) {
+            continue;
+        }
+        auto const [j, coefficient] = *std::find_if(row.entries.begin(), row.entries.end(),
+                                                    [this](auto const& entry) { return not _fixed[entry.first]; });
+        auto const& var = model.variables()[j];
+        if (sos_variables[j] or var.type() != VariableType::Continuous) {
+            continue;
+        }
+        double const value = -row.constant / coefficient;
+        if (value < var.lb() - TOLERANCE or value > var.ub() + TOLERANCE) {
+            continue;
+        }
+        row.removed = true;
+        _singleton_rows.emplace_back(i, j);
+        ++_statistics.singleton_rows;
+        fix_variable(j, std::clamp(value, var.lb(), var.ub()), rows, changed_rows);
+    }
+}
+
+void SOCPresolver::fix_variable(size_t const variable, double const value, std::vector<Row>& rows,
+                                std::vector<size_t>& changed_rows) {
+    _fixed[variable] = true;
+    _fixed_values[variable] = value;
+    for (auto const& [i, coefficient]: _columns[variable]) {
+        rows[i].constant += coefficient * value;
+        --rows[i].active_entries;
+        changed_rows.push_back(i);
+    }
+}
+
+void SOCPresolver::merge_parallel_rows(std::vector<Row>& rows) {
+    // rows are only compared to earlier rows with the same columns, one representative per bound
+    std::unordered_map<size_t, std::vector<size_t>> representatives;
+    std::vector<Entries> normalized(rows.size());
+    std::vector<Bound> bounds(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (not rows[i].affine or rows[i].removed or rows[i].active_entries == 0) {
+            continue;
+        }
+        normalized[i] = normalized_row(rows[i], bounds[i]);
+        size_t hash = 0;
+        for (auto const& entry: normalized[i]) {
+            hash ^= std::hash<size_t>{}(entry.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        auto& bucket = representatives[hash];
+        bool merged = false;
+        for (auto& k: bucket) {
+            if (not parallel(normalized[k], normalized[i])) {
+                continue;
+            }
+            auto const implication = first_implies_second(bounds[k], bounds[i]);
+            if (not implication.has_value()) {
+                continue;
+            }
+            if (implication.value()) {
+                rows[i].removed = true;
+            } else {
+                rows[k].removed = true;
+                k = i;
+            }
+            _parallel_representatives[k] = true;
+            ++_statistics.parallel_rows;
+            merged = true;
+            break;
+        }
+        if (not merged) {
+            bucket.push_back(i);
+        }
+    }
+}
+
+bool SOCPresolver::parallel(Entries const& first, Entries const& second) {
+    if (first.size() != second.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < first.size(); ++k) {
+        if (first[k].first != second[k].first
+            or std::abs(first[k].second - second[k].second) > TOLERANCE * std::max(1., std::abs(first[k].second))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SOCPresolver::Entries SOCPresolver::normalized_row(Row const& row, Bound& bound) const {
+    Entries normalized;
+    double scale = 0;
+    for (auto const& [j, coefficient]: row.entries) {
+        if (_fixed[j]) {
+            continue;
+        }
+        if (scale == 0) {
+            scale = coefficient;
+        }
+        normalized.emplace_back(j, coefficient / scale);
+    }
+    auto sense = row.sense;
+    if (scale < 0 and sense != ConstraintSense::EQ) {
+        sense = sense == ConstraintSense::LEQ ? ConstraintSense::GEQ : ConstraintSense::LEQ;
+    }
+    bound = {-row.constant / scale, sense};
+    return normalized;
+}
+
+std::optional<bool> SOCPresolver::first_implies_second(Bound const& first, Bound const& second) {
+    auto const& [first_rhs, first_sense] = first;
+    auto const& [second_rhs, second_sense] = second;
+    if (first_sense == ConstraintSense::EQ) {
+        if (satisfied(first_rhs - second_rhs, second_sense)) {
+            return true;
+        }
+        return {};
+    }
+    if (second_sense == ConstraintSense::EQ) {
+        if (satisfied(second_rhs - first_rhs, first_sense)) {
+            return false;
+        }
+        return {};
+    }
+    if (first_sense != second_sense) {
+        return {};
+    }
+    // the tighter of two inequalities is kept
+    return satisfied(first_rhs - second_rhs, second_sense);
+}
+
+bool SOCPresolver::satisfied(double const activity, ConstraintSense const sense) {
+    switch (sense) {
+        case ConstraintSense::LEQ:
+            return activity <= TOLERANCE;
+        case ConstraintSense::GEQ:
+            return activity >= -TOLERANCE;
+        case ConstraintSense::EQ:
+            return std::abs(activity) <= TOLERANCE;
+    }
+    helpers::exception_check(false, "Forbidden Case!");
+    return false;
+}
+
+void SOCPresolver::build_reduced_model(SOCModel const& model, std::vector<Row> const& rows) {
+    _reduced_model = std::make_unique<SOCModel>(model.name() + "Presolved");
+    for (auto const& var: model.variables()) {
+        add_reduced_variable(var);
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (not rows[i].removed) {
+            add_reduced_constraint(model.soc_constraints()[i], i);
+        }
+    }
+    for (auto const& sos: model.sos_constraints()) {
+        add_reduced_sos_constraint(sos);
+    }
+    set_reduced_objectives(model);
+    add_reduced_start_values(model);
+    _statistics.reduced_variables = reduced_model().variables().size();
+    _statistics.reduced_constraints = reduced_model().soc_constraints().size();
+}
+
+void SOCPresolver::add_reduced_variable(SOCVariable const& var) {
+    size_t const j = var.id().raw_id();
+    if (_fixed[j]) {
+        _substitutions.emplace_back(_fixed_values[j]);
+        return;
+    }
+    _reduced_variables[j] = reduced_model().variables().size();
+    _substitutions.emplace_back(reduced_model().add_variable(var.name(), var.lb(), var.ub(), var.type()));
+}
+
+void SOCPresolver::add_reduced_constraint(SOCModel::Constraint const& constr, size_t const constraint_number) {
+    _reduced_constraints[constraint_number] = reduced_model().soc_constraints().size();
+    reduced_model().add_constraint(constr.template substitute<SOCVariable>(_substitutions));
+}
+
+void SOCPresolver::add_reduced_sos_constraint(SOSConstraint const& sos) {
+    std::vector<SOCVariable::Reference> exclusive_variables;
+    for (auto const& var: sos.exclusive_variables()) {
+        exclusive_variables.emplace_back(
+                reduced_model().variables()[_reduced_variables[var.raw_id()].value()].reference());
+    }
+    reduced_model().add_sos_constraint(exclusive_variables);
+}
+
+void SOCPresolver::set_reduced_objectives(SOCModel const& model) {
+    auto const reduced_objective = [this](SOCModel::Objective const& objective) {
+        return SOCModel::Objective(objective.sense(),
+                                   objective.expression().template substitute<SOCVariable::Reference>(_substitutions));
+    };
+    // replaced objectives are replaced in the reduced model as well, otherwise only the added ones are added
+    size_t first_objective = reduced_model().objectives().size();
+    if (model.objective_revision() != _objective_revision and not model.objectives().empty()) {
+        reduced_model().clear_and_set_objective(reduced_objective(model.objectives().front()));
+        first_objective = 1;
+    }
+    for (size_t k = first_objective; k < model.objectives().size(); ++k) {
+        reduced_model().add_objective(reduced_objective(model.objectives()[k]));
+    }
+    _objective_revision = model.objective_revision();
+
+    std::fill(_objective_coefficients.begin(), _objective_coefficients.end(), 0.);
+    if (not model.objectives().empty()) {
+        for (auto const& svar: model.objective().expression().linear().scaled_variables()) {
+            _objective_coefficients[svar.variable().raw_id()] += svar.scale();
+        }
+    }
+}
+
+void SOCPresolver::add_reduced_start_values(SOCModel const& model) {
+    std::vector<std::pair<SOCVariable::Reference, double>> start_values;
+    for (auto const& start: model.start_values()) {
+        auto const& reduced_variable = _reduced_variables.at(start.variable.raw_id());
+        if (reduced_variable.has_value()) {
+            start_values.emplace_back(reduced_model().variables()[reduced_variable.value()].reference(), start.value);
+        }
+    }
+    reduced_model().set_start_values(start_values);
+}
+
+void SOCPresolver::postsolve(SOCModel& model) const {
+    helpers::exception_check(model.variables().size() == _fixed.size()
+                             and model.soc_constraints().size() == _reduced_constraints.size(),
+                             "Postsolve needs the model, which was presolved!");
+    auto const& reduced = reduced_model();
+    helpers::exception_check(std::all_of(reduced.variables().begin(), reduced.variables().end(),
+                                         [](auto const& var) { return var.has_solution(); }),
+                             "Postsolve needs a solution of the reduced model!");
+    model.invalidate_solution();
+    Solution solution{_fixed_values};
+    for (size_t j = 0; j < _reduced_variables.size(); ++j) {
+        if (_reduced_variables[j].has_value()) {
+            solution.values[j] = reduced.variables()[_reduced_variables[j].value()].solution();
+        }
+    }
+    model.set_solution(solution);
+
+    if (not std::all_of(reduced.soc_constraints().begin(), reduced.soc_constraints().end(),
+                        [](auto const& constr) { return constr.has_dual_value(); })
+        or not std::all_of(reduced.variables().begin(), reduced.variables().end(),
+                           [](auto const& var) { return var.has_reduced_cost(); })) {
+        return;
+    }
+    // the reduced costs of removed variables need the duals of the norm constraints, which are not known
+    if (not (model.all_affine() and (not model.is_multi_objective()) and model.is_continuous())) {
+        helpers::warning_throw("Dual values of the presolved " + model.name() + " are not restored, "
+                               "since it is not a continuous affine single objective model!");
+        return;
+    }
+    // removed empty and parallel rows have dual value 0, the reduced cost is c - A^T y as for the backends
+    std::vector<double> dual_values(_reduced_constraints.size(), 0.);
+    for (size_t i = 0; i < _reduced_constraints.size(); ++i) {
+        if (_reduced_constraints[i].has_value()) {
+            dual_values[i] = reduced.soc_constraints()[_reduced_constraints[i].value()].dual_value();
+        }
+    }
+    auto const reduced_cost = [&](size_t j) {
+        double value = _objective_coefficients[j];
+        for (auto const& [i, coefficient]: _columns[j]) {
+            value -= coefficient * dual_values[i];
+        }
+        return value;
+    };
+    // a row fixing a variable takes its whole reduced cost, only rows removed later share its column
+    for (auto it = _singleton_rows.rbegin(); it != _singleton_rows.rend(); ++it) {
+        auto const [i, j] = *it;
+        double const coefficient = std::find_if(_columns[j].begin(), _columns[j].end(),
+                                                [i](auto const& entry) { return entry.first == i; })->second;
+        dual_values[i] = reduced_cost(j) / coefficient;
+    }
+    std::vector<double> reduced_costs(_reduced_variables.size());
+    for (size_t j = 0; j < _reduced_variables.size(); ++j) {
+        reduced_costs[j] = _reduced_variables[j].has_value()
+                           ? reduced.variables()[_reduced_variables[j].value()].reduced_cost()
+                           : reduced_cost(j);
+    }
+    model.set_dual_soc_constraint_values(dual_values);
+    model.set_reduced_costs(reduced_costs);
+}
+
+double SOCPresolver::Solution::value(SOCVariable::Index const& id) const {
+    return values[id.raw_id()];
+}
+
+}
@@ -0,0 +1,137 @@
+#ifndef ROBUSTOPTIMIZATION_SOCPRESOLVER_H
+#define ROBUSTOPTIMIZATION_SOCPRESOLVER_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SOCModel.h"
+
+namespace robust_model {
+
+// Reduces a SOCModel before it is handed to a backend. Affine rows without variables are removed, equality rows
+// with a single continuous variable fix this variable, fixed variables are substituted by their value and parallel
+// affine rows are merged into the tightest one. Variables of sos constraints are kept.
+// Infeasibilities are not decided here, such rows stay in the reduced model and are left to the backend.
+// Later changes of the model are mapped onto the reduced model by update, as long as they keep the reductions valid.
+// postsolve restores the solution, the dual values and the reduced costs of the original model from the
+// solved reduced model. The backends report dual values for purely affine models only, for models with norm
+// constraints postsolve restores the solution alone.
+class SOCPresolver {
+public:
+    struct Statistics {
+        size_t original_variables = 0;
+        size_t original_constraints = 0;
+        size_t reduced_variables = 0;
+        size_t reduced_constraints = 0;
+        size_t empty_rows = 0;
+        size_t singleton_rows = 0;
+        size_t fixed_variables = 0;
+        size_t parallel_rows = 0;
+
+        std::string to_string() const;
+    };
+
+public:
+    explicit SOCPresolver(SOCModel const& model);
+
+    SOCModel const& reduced_model() const;
+    SOCModel & reduced_model();
+
+    Statistics const& statistics() const;
+
+    // applies the variables, constraints, sos constraints and objectives added to the model, its logged
+    // coefficient changes and its start values to the reduced model; false if a change affects a removed row or variable or a row, which
+    // made another row redundant, then the model has to be presolved again and the reduced model is not usable
+    bool update(SOCModel const& model);
+
+    // transfers the results of the solved reduced model to the model this presolver was created from
+    void postsolve(SOCModel& model) const;
+
+private:
+    using Entries = std::vector<std::pair<size_t, double>>;
+
+    // affine row  entries^T x + constant (sense) 0  with merged columns, inactive entries belong to fixed variables
+    struct Row {
+        bool affine = true;
+        Entries entries;
+        double constant = 0;
+        ConstraintSense sense = ConstraintSense::EQ;
+        size_t active_entries = 0;
+        bool removed = false;
+    };
+
+    // row of an affine constraint, whose entries are added to the columns
+    Row affine_row(SOCModel::Constraint const& constr, size_t constraint_number);
+
+    void fix_variables(SOCModel const& model, std::vector<Row>& rows);
+
+    void fix_variable(size_t variable, double value, std::vector<Row>& rows, std::vector<size_t>& changed_rows);
+
+    void merge_parallel_rows(std::vector<Row>& rows);
+
+    static bool parallel(Entries const& first, Entries const& second);
+
+    // right hand side and sense of a row  a^T x (sense) rhs  with normalized coefficients a
+    using Bound = std::pair<double, ConstraintSense>;
+
+    // active entries divided by the first active coefficient, the sense is flipped for negative coefficients
+    Entries normalized_row(Row const& row, Bound& bound) const;
+
+    // true if the first of two parallel rows implies the second, false if the second implies the first,
+    // empty if both are needed
+    static std::optional<bool> first_implies_second(Bound const& first, Bound const& second);
+
+    static bool satisfied(double activity, ConstraintSense sense);
+
+    void build_reduced_model(SOCModel const& model, std::vector<Row> const& rows);
+
+    void add_reduced_variable(SOCVariable const& var);
+
+    void add_reduced_constraint(SOCModel::Constraint const& constr, size_t constraint_number);
+
+    void add_reduced_sos_constraint(SOSConstraint const& sos);
+
+    void set_reduced_objectives(SOCModel const& model);
+
+    // start values of variables, which are not fixed
+    void add_reduced_start_values(SOCModel const& model);
+
+    struct Solution {
+        std::vector<double> values;
+
+        double value(SOCVariable::Index const& id) const;
+    };
+
+private:
+    std::unique_ptr<SOCModel> _reduced_model;
+    Statistics _statistics;
+
+    // reduced index of each variable and constraint of the original model, empty if removed
+    std::vector<std::optional<size_t>> _reduced_variables;
+    std::vector<std::optional<size_t>> _reduced_constraints;
+    std::vector<bool> _fixed;
+    std::vector<double> _fixed_values;
+    // fixed value or reduced variable of each variable of the original model
+    std::vector<AffineExpression<SOCVariable::Reference>> _substitutions;
+
+    // rows kept in place of a parallel row, their changes would invalidate the merge
+    std::vector<bool> _parallel_representatives;
+    size_t _objective_revision = 0;
+
+    // rows that fixed their variable, in the order of removal
+    std::vector<std::pair<size_t, size_t>> _singleton_rows;
+
+    // affine rows of each variable and the coefficients of the first objective for the dual postsolve
+    std::vector<Entries> _columns;
+    std::vector<double> _objective_coefficients;
+
+    // coefficients and activities within this tolerance are treated as equal
+    static constexpr double TOLERANCE = 1e-9;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_SOCPRESOLVER_H
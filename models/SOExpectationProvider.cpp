@@ -1,9 +1,65 @@
 #include "SOExpectationProvider.h"
 #include "UncertaintySet.h"
 
+#include <algorithm>
+#include <tuple>
+
 
 namespace robust_model {
 
+std::vector<double> const& SOExpectationProvider::first_moments() const {
+    std::lock_guard<std::mutex> const lock(_moments_mutex);
+    if (not _first_moments.has_value()) {
+        _first_moments = expected_value([](UncertaintyRealization const& realization) {
+            return realization.values();
+        });
+    }
+    return _first_moments.value();
+}
+
+std::vector<double>
+SOExpectationProvider::second_moments(std::vector<std::pair<size_t, size_t>> const& pairs) const {
+    std::lock_guard<std::mutex> const lock(_moments_mutex);
+    auto const ordered = [](std::pair<size_t, size_t> const& pair) {
+        return std::make_pair(std::min(pair.first, pair.second), std::max(pair.first, pair.second));
+    };
+    std::vector<std::pair<size_t, size_t>> missing;
+    for (auto const& pair: pairs) {
+        if (not _second_moments.contains(ordered(pair))) {
+            missing.push_back(ordered(pair));
+        }
+    }
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    if (not missing.empty()) {
+        // lifted realizations are mostly zero, so only the nonzero products are passed on
+        auto const moments = expected_value(
+                [&missing](UncertaintyRealization const& realization, SparseEntries& products) {
+                    auto const& values = realization.values();
+                    for (size_t k = 0; k < missing.size(); ++k) {
+                        double const product = values[missing[k].first] * values[missing[k].second];
+                        if (product != 0) {
+                            products.emplace_back(k, 0, product);
+                        }
+                    }
+                });
+        // cached only after the sweep succeeded, so that a failed sweep leaves no moments behind
+        std::vector<double> missing_moments(missing.size(), 0.);
+        for (auto const& [k, column, moment]: moments) {
+            missing_moments[k] = moment;
+        }
+        for (size_t k = 0; k < missing.size(); ++k) {
+            _second_moments[missing[k]] = missing_moments[k];
+        }
+    }
+    std::vector<double> values;
+    values.reserve(pairs.size());
+    for (auto const& pair: pairs) {
+        values.push_back(_second_moments.at(ordered(pair)));
+    }
+    return values;
+}
+
 
 SOExpectationProviderEmpirical::SOExpectationProviderEmpirical(
         std::vector<UncertaintyRealization> empirical_uncertainty_realizations) :
@@ -29,12 +85,14 @@ std::vector<double> SOExpectationProviderEmpirical::expected_value(
     std::vector<double> ev;
     for (auto const& realization: _empirical_uncertainty_realizations) {
         auto res = fct(realization);
-        if (ev.empty())
+        if (ev.empty()) {
             ev = std::move(res);
-        else
-            for (size_t i = 0; i < ev.size(); ++i) {
-                ev.at(i) += res.at(i);
-            }
+            continue;
+        }
+        helpers::exception_check(res.size() == ev.size(), "Expected value of vectors of different sizes!");
+        for (size_t i = 0; i < ev.size(); ++i) {
+            ev[i] += res[i];
+        }
     }
     for (auto& val: ev) {
         val /= double(_empirical_uncertainty_realizations.size());
@@ -47,14 +105,17 @@ std::vector<std::vector<double>> SOExpectationProviderEmpirical::expected_value(
     std::vector<std::vector<double>> ev;
     for (auto const& realization: _empirical_uncertainty_realizations) {
         auto res = fct(realization);
-        if (ev.empty())
+        if (ev.empty()) {
             ev = std::move(res);
-        else
-            for (size_t i = 0; i < ev.size(); ++i) {
-                for (size_t j = 0; j < ev.at(i).size(); ++j) {
-                    ev.at(i).at(j) += res.at(i).at(j);
-                }
+            continue;
+        }
+        helpers::exception_check(res.size() == ev.size(), "Expected value of matrices of different sizes!");
+        for (size_t i = 0; i < ev.size(); ++i) {
+            helpers::exception_check(res[i].size() == ev[i].size(), "Expected value of matrices of different sizes!");
+            for (size_t j = 0; j < ev[i].size(); ++j) {
+                ev[i][j] += res[i][j];
             }
+        }
     }
     for (auto& row: ev) {
         for (auto& val: row) {
@@ -64,6 +125,48 @@ std::vector<std::vector<double>> SOExpectationProviderEmpirical::expected_value(
     return ev;
 }
 
+SOExpectationProvider::SparseEntries SOExpectationProviderEmpirical::expected_value(
+        std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const {
+    // the entries of all realizations are collected and merged, whenever they outgrow twice the merged entries
+    SparseEntries entries;
+    SparseEntries ev;
+    size_t merged_size = 0;
+    for (auto const& realization: _empirical_uncertainty_realizations) {
+        entries.clear();
+        fct(realization, entries);
+        ev.insert(ev.end(), entries.begin(), entries.end());
+        if (ev.size() > std::max(2 * merged_size, MIN_MERGE_SIZE)) {
+            merge_entries(ev);
+            merged_size = ev.size();
+        }
+    }
+    merge_entries(ev);
+    for (auto& [row, column, value]: ev) {
+        value /= double(_empirical_uncertainty_realizations.size());
+    }
+    return ev;
+}
+
+void SOExpectationProviderEmpirical::merge_entries(SparseEntries& entries) {
+    std::sort(entries.begin(), entries.end(), [](auto const& first, auto const& second) {
+        return std::tie(std::get<0>(first), std::get<1>(first)) < std::tie(std::get<0>(second), std::get<1>(second));
+    });
+    size_t merged = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (merged > 0 and std::get<0>(entries[merged - 1]) == std::get<0>(entries[i]) and
+            std::get<1>(entries[merged - 1]) == std::get<1>(entries[i])) {
+            std::get<2>(entries[merged - 1]) += std::get<2>(entries[i]);
+        } else {
+            entries[merged++] = entries[i];
+        }
+    }
+    entries.resize(merged);
+}
+
+
+std::vector<UncertaintyRealization> const& SOExpectationProviderEmpirical::realizations() const {
+    return _empirical_uncertainty_realizations;
+}
 
 std::vector<UncertaintyRealization> SOExpectationProviderEmpirical::convert_to_realization_vector(
         std::vector<std::vector<double>> empirical_uncertainty_realizations) {
@@ -74,5 +177,31 @@ std::vector<UncertaintyRealization> SOExpectationProviderEmpirical::convert_to_r
     return realizations;
 }
 
+SOExpectationProviderReference::SOExpectationProviderReference(SOExpectationProvider const& base_expectation_provider) :
+        _base_expectation_provider(base_expectation_provider) {}
+
+SOExpectationProvider const& SOExpectationProviderReference::base_expectation_provider() const {
+    return _base_expectation_provider;
+}
+
+double SOExpectationProviderReference::expected_value(
+        std::function<double(UncertaintyRealization const&)> const& fct) const {
+    return _base_expectation_provider.expected_value(fct);
+}
+
+std::vector<double> SOExpectationProviderReference::expected_value(
+        std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const {
+    return _base_expectation_provider.expected_value(fct);
+}
 
-}
\ No newline at end of file
+std::vector<std::vector<double>> SOExpectationProviderReference::expected_value(
+        std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const {
+    return _base_expectation_provider.expected_value(fct);
+}
+
+SOExpectationProvider::SparseEntries SOExpectationProviderReference::expected_value(
+        std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const {
+    return _base_expectation_provider.expected_value(fct);
+}
+
+}
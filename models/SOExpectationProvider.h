@@ -2,6 +2,11 @@
 #define PIECEWISEAFFINEADJUSTABLEOPTIMIZATION_SOEXPECTATIONPROVIDER_H
 
 #include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace robust_model {
@@ -9,11 +14,29 @@ namespace robust_model {
 class UncertaintyRealization;
 
 class SOExpectationProvider {
+public:
+    // entries (row, column, value) of a sparse matrix
+    using SparseEntries = std::vector<std::tuple<size_t, size_t, double>>;
+
 public:
     virtual ~SOExpectationProvider() = default;
     virtual double expected_value(std::function<double(UncertaintyRealization const&)> const& fct) const = 0;
     virtual std::vector<double> expected_value(std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const = 0;
     virtual std::vector<std::vector<double>> expected_value(std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const = 0;
+    // the function appends the nonzero entries of a realization to the given buffer, which is cleared and reused
+    // for every realization; the result is sorted by row and column, duplicate entries are summed
+    virtual SparseEntries expected_value(std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const = 0;
+
+    // E[u_i] of all uncertainty variables by raw id, computed by one sweep over the realizations on first use
+    std::vector<double> const& first_moments() const;
+
+    // E[u_i u_j] for the given pairs of raw ids, pairs not seen before are computed by one joint sweep and cached
+    std::vector<double> second_moments(std::vector<std::pair<size_t, size_t>> const& pairs) const;
+
+private:
+    mutable std::mutex _moments_mutex;
+    mutable std::optional<std::vector<double>> _first_moments;
+    mutable std::map<std::pair<size_t, size_t>, double> _second_moments;
 };
 
 class SOExpectationProviderEmpirical : public SOExpectationProvider {
@@ -24,14 +47,39 @@ public:
     double expected_value(std::function<double(UncertaintyRealization const&)> const& fct) const final;
     std::vector<double> expected_value(std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const final;
     std::vector<std::vector<double>> expected_value(std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const override;
+    SparseEntries expected_value(std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const final;
 
+    // the realizations, which are weighted uniformly
+    std::vector<UncertaintyRealization> const& realizations() const;
 
 private:
     static std::vector<UncertaintyRealization> convert_to_realization_vector(
             std::vector<std::vector<double>> empirical_uncertainty_realizations);
 
+    // sorts the entries by row and column and sums duplicates
+    static void merge_entries(SparseEntries& entries);
+
 private:
     std::vector<UncertaintyRealization> const _empirical_uncertainty_realizations;
+
+    // entries collected before they are merged for the first time
+    static constexpr size_t MIN_MERGE_SIZE = 1 << 16;
+};
+
+// forwards to the provider of another model with the same uncertainty variables, which has to outlive this one
+class SOExpectationProviderReference : public SOExpectationProvider {
+public:
+    explicit SOExpectationProviderReference(SOExpectationProvider const& base_expectation_provider);
+
+    double expected_value(std::function<double(UncertaintyRealization const&)> const& fct) const final;
+    std::vector<double> expected_value(std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const final;
+    std::vector<std::vector<double>> expected_value(std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const final;
+    SparseEntries expected_value(std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const final;
+
+    SOExpectationProvider const& base_expectation_provider() const;
+
+private:
+    SOExpectationProvider const& _base_expectation_provider;
 };
 
 }
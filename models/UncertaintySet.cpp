@@ -46,6 +46,19 @@ std::vector<UncertaintySetConstraintsSet::Constraint> const& UncertaintySetConst
     return _uncertainty_constraints;
 }
 
+void UncertaintySetConstraintsSet::set_constraint_constant(size_t const constraint_number, double const constant) {
+    auto& constraint = _uncertainty_constraints.at(constraint_number);
+    auto const& expression = constraint.soc_expression();
+    AffineExpression<UncertaintyVariable::Reference> const affine(constant, expression.affine().linear());
+    if (expression.is_affine()) {
+        constraint = Constraint(constraint.sense(), SOCExpression<UncertaintyVariable>(affine), constraint.name());
+    } else {
+        constraint = Constraint(constraint.sense(),
+                                SOCExpression<UncertaintyVariable>(expression.normed_vector(), affine),
+                                constraint.name());
+    }
+}
+
 bool UncertaintySetConstraintsSet::is_box() const {
     return std::all_of(_uncertainty_constraints.begin(), _uncertainty_constraints.end(),
                        [](auto const& constr) {
@@ -185,6 +198,16 @@ UncertaintySet::uncertainty_constraints(UncertaintySetConstraintsSet::Index cons
     return constraint_set->constraints();
 }
 
+void UncertaintySet::set_uncertainty_constraint_constant(UncertaintySetConstraintsSet::Index constraint_set,
+                                                         size_t const constraint_number, double const constant) {
+    helpers::IndexedObjectOwner<UncertaintySetConstraintsSet>::object(constraint_set).set_constraint_constant(
+            constraint_number, constant);
+}
+
+void UncertaintySet::set_variable_bounds(UncertaintyVariable::Index const& variable, double const lb, double const ub) {
+    helpers::IndexedObjectOwner<UncertaintyVariable>::object(variable).set_bounds(lb, ub);
+}
+
 UncertaintySetConstraintsSet::Index UncertaintySet::add_constraint_set() {
     return helpers::IndexedObjectOwner<UncertaintySetConstraintsSet>::base_add_object(*this);
 }
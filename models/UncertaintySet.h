@@ -34,6 +34,9 @@ public:
 
     std::vector<Constraint> const& constraints() const;
 
+    // replaces the constant d of the affine part of the constraint, the structure of the constraint is kept
+    void set_constraint_constant(size_t constraint_number, double constant);
+
     bool is_box() const;
 
     bool is_empty() const;
@@ -110,6 +113,11 @@ public:
 
     std::vector<Constraint> const& uncertainty_constraints(UncertaintySetConstraintsSet::Index constraint_set) const;
 
+    void set_uncertainty_constraint_constant(UncertaintySetConstraintsSet::Index constraint_set,
+                                             size_t constraint_number, double constant);
+
+    void set_variable_bounds(UncertaintyVariable::Index const& variable, double lb, double ub);
+
     UncertaintySetConstraintsSet::Index add_constraint_set();
 
     std::vector<UncertaintySetConstraintsSet::Index> const& constraint_sets() const;
@@ -49,8 +49,9 @@ private:
     double accumulated_vector_values(std::vector<double> const& values) const;
 
 private:
-    VectorNormType const _norm_type;
-    std::vector<AffineExpression<typename V::Reference>> const _normed_vector;
+    // not const, so that constraints holding the vector can be assigned, when a parametric update replaces them
+    VectorNormType _norm_type;
+    std::vector<AffineExpression<typename V::Reference>> _normed_vector;
 
 };
 
@@ -63,8 +63,13 @@ void SOCVariable::set_solution(double sol) {
     _solution = sol;
 }
 
+void SOCVariable::set_reduced_cost(double reduced_cost) {
+    _reduced_cost = reduced_cost;
+}
+
 void SOCVariable::invalidate_solution() {
     _solution = {};
+    _reduced_cost = {};
 }
 
 bool SOCVariable::has_solution() const {
@@ -76,6 +81,15 @@ double SOCVariable::solution() const {
     return _solution.value();
 }
 
+bool SOCVariable::has_reduced_cost() const {
+    return _reduced_cost.has_value();
+}
+
+double SOCVariable::reduced_cost() const {
+    helpers::exception_check(_reduced_cost.has_value(), "No reduced cost available!");
+    return _reduced_cost.value();
+}
+
 VariableType const SOCVariable::type() const {
     return _type;
 }
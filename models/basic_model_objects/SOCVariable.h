@@ -49,12 +49,17 @@ public:
                 VariableType type);
 
     void set_solution(double sol);
+    void set_reduced_cost(double reduced_cost);
     void invalidate_solution();
 
     bool has_solution() const;
 
     double solution() const;
 
+    bool has_reduced_cost() const;
+
+    double reduced_cost() const;
+
     VariableType const type() const;
 
     bool has_dual_info() const;
@@ -62,6 +67,7 @@ public:
 
 private:
     std::optional<double> _solution;
+    std::optional<double> _reduced_cost;
     VariableType const _type;
     std::optional<DualInformation> const _dual_info;
 };
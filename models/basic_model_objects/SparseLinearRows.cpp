@@ -0,0 +1,72 @@
+#include "SparseLinearRows.h"
+
+namespace robust_model {
+
+SparseLinearRows::SparseLinearRows() : _row_starts({0}) {}
+
+void SparseLinearRows::add_row(AffineExpression<SOCVariable::Reference> const& affine, ConstraintSense const sense) {
+    int const row_start = _row_starts.back();
+    for (auto const& svar: affine.linear().scaled_variables()) {
+        size_t const column = svar.variable().raw_id();
+        if (column >= _column_positions.size()) {
+            _column_positions.resize(column + 1, -1);
+        }
+        int& position = _column_positions[column];
+        if (position >= row_start) {
+            _values[position] += svar.scale();
+            continue;
+        }
+        position = int(_column_indices.size());
+        _column_indices.emplace_back(int(column));
+        _values.emplace_back(svar.scale());
+    }
+    // reset the markers, so that the next row does not see stale positions
+    for (size_t k = size_t(row_start); k < _column_indices.size(); ++k) {
+        _column_positions[_column_indices[k]] = -1;
+    }
+    _row_starts.emplace_back(int(_column_indices.size()));
+    _senses.emplace_back(sense);
+    _rhs.emplace_back(-affine.constant());
+}
+
+void SparseLinearRows::clear() {
+    _row_starts = {0};
+    _column_indices.clear();
+    _values.clear();
+    _senses.clear();
+    _rhs.clear();
+}
+
+bool SparseLinearRows::empty() const {
+    return _senses.empty();
+}
+
+size_t SparseLinearRows::num_rows() const {
+    return _senses.size();
+}
+
+size_t SparseLinearRows::num_nonzeros() const {
+    return _column_indices.size();
+}
+
+std::vector<int> const& SparseLinearRows::row_starts() const {
+    return _row_starts;
+}
+
+std::vector<int> const& SparseLinearRows::column_indices() const {
+    return _column_indices;
+}
+
+std::vector<double> const& SparseLinearRows::values() const {
+    return _values;
+}
+
+std::vector<ConstraintSense> const& SparseLinearRows::senses() const {
+    return _senses;
+}
+
+std::vector<double> const& SparseLinearRows::rhs() const {
+    return _rhs;
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef ROBUSTOPTIMIZATION_SPARSELINEARROWS_H
+#define ROBUSTOPTIMIZATION_SPARSELINEARROWS_H
+
+#include <vector>
+
+#include "SOCVariable.h"
+#include "AffineExpression.h"
+
+namespace robust_model {
+
+// Flattens affine rows  sum_k values[k] * x[column_indices[k]]  (sense)  rhs  into compressed sparse row arrays.
+// Row r occupies the positions row_starts[r] to row_starts[r+1]-1. Duplicate variables within a row are merged.
+class SparseLinearRows {
+public:
+    SparseLinearRows();
+
+    void add_row(AffineExpression<SOCVariable::Reference> const& affine, ConstraintSense sense);
+
+    void clear();
+
+    bool empty() const;
+
+    size_t num_rows() const;
+
+    size_t num_nonzeros() const;
+
+    std::vector<int> const& row_starts() const;
+
+    std::vector<int> const& column_indices() const;
+
+    std::vector<double> const& values() const;
+
+    std::vector<ConstraintSense> const& senses() const;
+
+    std::vector<double> const& rhs() const;
+
+private:
+    std::vector<int> _row_starts;
+    std::vector<int> _column_indices;
+    std::vector<double> _values;
+    std::vector<ConstraintSense> _senses;
+    std::vector<double> _rhs;
+
+    // position of a column inside the row currently being added, -1 if not present
+    std::vector<int> _column_positions;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_SPARSELINEARROWS_H
@@ -26,10 +26,13 @@ public:
 
     bool bounded() const;
 
+    void set_bounds(double lb, double ub);
+
 private:
     std::string const _name;
-    double const _lb;
-    double const _ub;
+    // changed by set_bounds only, parametric uncertainty sets update the bounds of their variables
+    double _lb;
+    double _ub;
 };
 
 }
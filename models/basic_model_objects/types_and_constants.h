@@ -1,9 +1,9 @@
 #ifndef ROBUSTOPTIMIZATION_TYPES_AND_CONSTANTS_H
 #define ROBUSTOPTIMIZATION_TYPES_AND_CONSTANTS_H
 
+#include <limits>
 #include <string>
 #include "../../helpers/helpers.h"
-#include "gurobi_c++.h"
 
 namespace robust_model{
 static constexpr double NO_VARIABLE_UB = std::numeric_limits<double>::infinity();
@@ -27,18 +27,6 @@ static std::string sense_string(ConstraintSense s){
     return "";
 }
 
-static char to_grb_sense(ConstraintSense s){
-    switch (s) {
-        case ConstraintSense::GEQ:
-            return GRB_GREATER_EQUAL;
-        case ConstraintSense::LEQ:
-            return GRB_LESS_EQUAL;
-        case ConstraintSense::EQ:
-            return GRB_EQUAL;
-    }
-    return char();
-}
-
 enum class ObjectiveSense {
     MIN, MAX
 };
@@ -55,18 +43,6 @@ static std::string sense_string(ObjectiveSense sense) {
     }
 }
 
-static int to_grb_sense(ObjectiveSense sense){
-    switch (sense) {
-        case ObjectiveSense::MIN:
-            return GRB_MINIMIZE;
-        case ObjectiveSense::MAX:
-            return GRB_MAXIMIZE;
-        default:
-            helpers::exception_check(false, "Forbidden Case!");
-            return 0;
-    }
-}
-
 enum class VectorNormType{
     One, Two, Max
 };
@@ -117,20 +93,6 @@ static std::string type_string(VariableType var_type){
     }
 }
 
-static char to_grb_type(VariableType sense){
-    switch (sense) {
-        case VariableType::Continuous:
-            return GRB_CONTINUOUS;
-        case VariableType::Binary:
-            return GRB_BINARY;
-        case VariableType::Integer:
-            return GRB_INTEGER;
-        default:
-            helpers::exception_check(false, "Forbidden Case!");
-            return 0;
-    }
-}
-
 }
 
 
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cmath>
 
 #include "SolverBase.h"
@@ -15,6 +16,13 @@ bool SolverBase::built() const {
 }
 
 void SolverBase::solve() {
+    if (_owns_cancel_request) {
+        _cancel_request->store(false);
+    }
+    run_solve();
+}
+
+void SolverBase::run_solve() {
     if (not built()) {
         build();
     }
@@ -22,6 +30,56 @@ void SolverBase::solve() {
     solve_implementation();
 }
 
+SolverBase::AsyncSolve SolverBase::solve_async() {
+    // reset here and not in the thread, so that a cancel right after the start is not lost
+    if (_owns_cancel_request) {
+        _cancel_request->store(false);
+    }
+    return {*this, std::async(std::launch::async, [this]() { run_solve(); }).share()};
+}
+
+void SolverBase::cancel() {
+    _cancel_request->store(true);
+}
+
+bool SolverBase::cancel_requested() const {
+    return _cancel_request->load();
+}
+
+void SolverBase::set_progress_callback(ProgressCallback const& callback) {
+    _progress_callback = callback;
+}
+
+bool SolverBase::has_progress_callback() const {
+    return bool(_progress_callback);
+}
+
+void SolverBase::report_progress(Progress const& progress) const {
+    if (_progress_callback) {
+        _progress_callback(progress);
+    }
+}
+
+SolverBase::AsyncSolve::AsyncSolve(SolverBase& solver, std::shared_future<void> future) :
+        _solver(solver), _future(std::move(future)) {}
+
+void SolverBase::AsyncSolve::cancel() {
+    _solver.cancel();
+}
+
+bool SolverBase::AsyncSolve::ready() const {
+    return _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void SolverBase::AsyncSolve::wait() const {
+    _future.wait();
+}
+
+SolverBase::Status SolverBase::AsyncSolve::get() const {
+    _future.get();
+    return _solver.status();
+}
+
 void SolverBase::set_runtime_limit(double limit) {
     _runtime_limit = limit;
 }
@@ -54,6 +112,60 @@ void SolverBase::set_memory_limit(std::optional<double> const& limit) {
     _memory_limit = limit;
 }
 
+void SolverBase::set_soc_encoding(SolverBase::SOCEncoding encoding) {
+    _soc_encoding = encoding;
+}
+
+SolverBase::SOCEncoding SolverBase::soc_encoding() const {
+    return _soc_encoding;
+}
+
+void SolverBase::set_soc_backend(SolverBase::SOCBackend backend) {
+#ifndef ROBUSTOPTIMIZATION_WITH_GUROBI
+    helpers::exception_check(backend != SOCBackend::GUROBI, "Gurobi was not found at build time!");
+#endif
+    _soc_backend = backend;
+}
+
+SolverBase::SOCBackend SolverBase::soc_backend() const {
+    return _soc_backend;
+}
+
+void SolverBase::set_soc_presolve(bool const presolve) {
+    _soc_presolve = presolve;
+}
+
+bool SolverBase::soc_presolve() const {
+    return _soc_presolve;
+}
+
+void SolverBase::set_build_threads(size_t const threads) {
+    helpers::exception_check(threads > 0, "At least one thread is needed to build the model!");
+    _build_threads = threads;
+}
+
+size_t SolverBase::build_threads() const {
+    return _build_threads;
+}
+
+SolverBase::SOCBackend SolverBase::default_soc_backend() {
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+    return SOCBackend::GUROBI;
+#else
+    return SOCBackend::ADMM;
+#endif
+}
+
+void SolverBase::set_parameters(SolverBase::Parameters const& parameters) {
+    helpers::exception_check(not parameters.threads.has_value() or parameters.threads.value() >= 0,
+                             "Number of threads must not be negative!");
+    _parameters = parameters;
+}
+
+SolverBase::Parameters const& SolverBase::parameters() const {
+    return _parameters;
+}
+
 std::optional<double> const& SolverBase::optional_runtime_limit() const {
     return _runtime_limit;
 }
@@ -98,9 +210,45 @@ void SolverBase::set_objective_value(double objective_value) {
     _objective_value = objective_value;
 }
 
+double SolverBase::model_transfer_time() const {
+    return _model_transfer_time;
+}
+
+SolverBase::ModelSize const& SolverBase::model_size() const {
+    return _model_size;
+}
+
+void SolverBase::set_model_size(ModelSize const& model_size) {
+    _model_size = model_size;
+}
+
+void SolverBase::Progress::set_interior_point_bound(double const dual_objective, double const dual_infeasibility,
+                                                   double const tolerance) {
+    if (dual_infeasibility <= tolerance) {
+        objective_bound = dual_objective;
+    }
+}
+
+std::string SolverBase::ModelSize::to_string() const {
+    return std::to_string(variables) + " variables, " + std::to_string(linear_constraints) + " linear constraints, "
+           + std::to_string(cone_constraints) + " cone constraints";
+}
+
+void SolverBase::set_model_transfer_time(double model_transfer_time) {
+    _model_transfer_time = model_transfer_time;
+}
+
 void SolverBase::set_parameters_from_other(SolverBase const& other) {
     set_runtime_limit(other.optional_runtime_limit());
     set_memory_limit(other.optional_memory_limit());
+    set_soc_encoding(other.soc_encoding());
+    set_soc_backend(other.soc_backend());
+    set_soc_presolve(other.soc_presolve());
+    set_build_threads(other.build_threads());
+    _progress_callback = other._progress_callback;
+    _cancel_request = other._cancel_request;
+    _owns_cancel_request = false;
+    set_parameters(other.parameters());
 }
 
 void SolverBase::set_parameters_to_other(SolverBase& other) const {
@@ -109,6 +257,8 @@ void SolverBase::set_parameters_to_other(SolverBase& other) const {
 
 void SolverBase::set_results_from_other(SolverBase const& other) {
     set_status(other.status());
+    set_model_transfer_time(other.model_transfer_time());
+    set_model_size(other.model_size());
     if (other.has_solution()) {
         set_runtime(other.runtime());
         set_objective_value(other.objective_value());
@@ -1,7 +1,12 @@
 #ifndef ROBUSTOPTIMIZATION_SOLVERBASE_H
 #define ROBUSTOPTIMIZATION_SOLVERBASE_H
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
 #include <optional>
+#include <string>
 #include "../helpers/helpers.h"
 
 namespace solvers {
@@ -12,7 +17,93 @@ public:
         UNSOLVED,
         OPTIMAL,
         TIME_LIMIT,
-        MEMORY_LIMIT
+        MEMORY_LIMIT,
+        INTERRUPTED
+    };
+
+    // how two norm constraints ||Ax+b|| + c^T x + d <= 0 are passed to the underlying solver
+    enum class SOCEncoding{
+        // auxiliary variables y = Ax+b and t = -(c^T x + d) >= 0 in the canonical cone ||y||^2 <= t^2
+        NATIVE_CONE,
+        // ||Ax+b||^2 <= (c^T x + d)^2 together with c^T x + d <= 0
+        SQUARED_QUADRATIC
+    };
+
+    // solver used for the second order cone models, Gurobi is only available when the library was found at build time
+    enum class SOCBackend{
+        GUROBI,
+        ADMM
+    };
+
+    // tuning parameters of the underlying solver, unset values keep the defaults of the solver
+    struct Parameters {
+        enum class Method{
+            AUTOMATIC,
+            PRIMAL_SIMPLEX,
+            DUAL_SIMPLEX,
+            BARRIER,
+            CONCURRENT
+        };
+
+        enum class Presolve{
+            AUTOMATIC,
+            OFF,
+            CONSERVATIVE,
+            AGGRESSIVE
+        };
+
+        std::optional<int> threads;
+        Method method = Method::AUTOMATIC;
+        std::optional<double> barrier_convergence_tolerance;
+        std::optional<double> barrier_qcp_convergence_tolerance;
+        bool crossover = true;
+        Presolve presolve = Presolve::AUTOMATIC;
+        std::optional<int> seed;
+    };
+
+    // intermediate state of a running solve, values the underlying solver does not report stay empty
+    struct Progress {
+        double runtime = 0;
+        std::optional<double> objective_value;
+        // only reported, when it provably bounds the optimal objective value
+        std::optional<double> objective_bound;
+        std::optional<double> primal_residual;
+        std::optional<double> dual_residual;
+
+        // the dual objective of an interior point iterate is a bound, once the iterate is dual feasible within
+        // the tolerance
+        void set_interior_point_bound(double dual_objective, double dual_infeasibility, double tolerance);
+    };
+
+    // size of the model as handed to the underlying solver, after the encoding of the two norm constraints
+    struct ModelSize {
+        size_t variables = 0;
+        size_t linear_constraints = 0;
+        size_t cone_constraints = 0;
+
+        std::string to_string() const;
+    };
+
+    // called from the thread running the solve
+    using ProgressCallback = std::function<void(Progress const&)>;
+
+    // handle of a solve running in its own thread, the solver has to outlive it
+    class AsyncSolve {
+    public:
+        AsyncSolve(SolverBase& solver, std::shared_future<void> future);
+
+        void cancel();
+
+        bool ready() const;
+
+        void wait() const;
+
+        // waits for the solve, exceptions thrown by the solve are rethrown here
+        Status get() const;
+
+    private:
+        SolverBase& _solver;
+        std::shared_future<void> _future;
     };
 
 public:
@@ -22,6 +113,16 @@ public:
     bool built() const;
 
     void solve();
+
+    AsyncSolve solve_async();
+
+    // asks the running solve to stop as soon as possible, it then ends with status INTERRUPTED
+    // the request is reset by the next solve
+    void cancel();
+
+    bool cancel_requested() const;
+
+    void set_progress_callback(ProgressCallback const& callback);
     // runtime limit in seconds
     void set_runtime_limit(double limit);
     void set_runtime_limit(std::optional<double> const& limit);
@@ -30,6 +131,19 @@ public:
     void set_memory_limit(double limit);
     void set_memory_limit(std::optional<double> const& limit);
 
+    void set_soc_encoding(SOCEncoding encoding);
+
+    // takes effect with the next solve, a backend created by an earlier solve is replaced
+    void set_soc_backend(SOCBackend backend);
+
+    void set_parameters(Parameters const& parameters);
+
+    // reduces the SOCModel by SOCPresolver before it is handed to the soc backend
+    void set_soc_presolve(bool presolve);
+
+    // threads used to build the model handed to the backend, independent of the threads of the backend
+    void set_build_threads(size_t threads);
+
     Status status() const;
 
     bool has_solution() const;
@@ -38,10 +152,29 @@ public:
 
     double objective_value() const;
 
+    // time in seconds spent transferring the model to the underlying solver
+    double model_transfer_time() const;
+
+    ModelSize const& model_size() const;
+
+    SOCEncoding soc_encoding() const;
+
+    SOCBackend soc_backend() const;
+
+    bool soc_presolve() const;
+
+    size_t build_threads() const;
+
+    static SOCBackend default_soc_backend();
+
+    Parameters const& parameters() const;
+
 protected:
     void set_status(Status status);
     void set_runtime(double runtime);
     void set_objective_value(double objective_value);
+    void set_model_transfer_time(double model_transfer_time);
+    void set_model_size(ModelSize const& model_size);
     bool has_runtime_limit() const;
     double runtime_limit() const;
     std::optional<double> const& optional_runtime_limit() const;
@@ -53,7 +186,12 @@ protected:
     void set_parameters_to_other(SolverBase & other) const;
     void set_results_from_other(SolverBase const& other);
 
+    bool has_progress_callback() const;
+    void report_progress(Progress const& progress) const;
+
 private:
+    void run_solve();
+
     virtual void build_implementation(){};
     virtual void update_implementation(){};
     virtual void solve_implementation() = 0;
@@ -62,8 +200,19 @@ private:
     Status _status = Status::UNSOLVED;
     std::optional<double> _runtime_limit;
     std::optional<double> _memory_limit;
+    SOCEncoding _soc_encoding = SOCEncoding::NATIVE_CONE;
+    SOCBackend _soc_backend = default_soc_backend();
+    bool _soc_presolve = false;
+    size_t _build_threads = 1;
+    // shared with the solvers this solver delegates to, only the owner resets it
+    std::shared_ptr<std::atomic<bool>> _cancel_request = std::make_shared<std::atomic<bool>>(false);
+    bool _owns_cancel_request = true;
+    ProgressCallback _progress_callback;
+    Parameters _parameters;
     std::optional<double> _runtime;
     std::optional<double> _objective_value;
+    double _model_transfer_time = 0;
+    ModelSize _model_size;
     bool _built = false;
     bool _encode_infeasible_results = true;
 };
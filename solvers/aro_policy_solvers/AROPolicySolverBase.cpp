@@ -8,5 +8,34 @@ robust_model::ROModel const& AROPolicySolverBase::model() const {
     return _model;
 }
 
+void AROPolicySolverBase::set_dependency_window(robust_model::period_id const periods) {
+    helpers::exception_check(periods > 0, "The dependency window has to contain at least one period!");
+    set_dependency_pattern([periods](robust_model::DecisionVariable const& dvar,
+                                     robust_model::UncertaintyVariable const& uvar) {
+        return not dvar.has_period() or not uvar.has_period() or uvar.period() > dvar.period() - periods;
+    });
+}
+
+void AROPolicySolverBase::set_dependency_pattern(DependencyPattern const& pattern) {
+    helpers::exception_check(not built(), "Dependency patterns have to be set before building!");
+    _dependency_pattern = pattern;
+}
+
+AROPolicySolverBase::DependencyPattern const& AROPolicySolverBase::dependency_pattern() const {
+    return _dependency_pattern;
+}
+
+std::vector<robust_model::UncertaintyVariable::Reference>
+AROPolicySolverBase::policy_dependencies(robust_model::DecisionVariable const& dvar) const {
+    std::vector<robust_model::UncertaintyVariable::Reference> dependencies;
+    for (auto const& uvar: dvar.dependencies()) {
+        auto const& uncertainty_variable = _model.uncertainty_variables().at(uvar.raw_id());
+        if (not _dependency_pattern or _dependency_pattern(dvar, uncertainty_variable)) {
+            dependencies.push_back(uvar);
+        }
+    }
+    return dependencies;
+}
+
 
 }
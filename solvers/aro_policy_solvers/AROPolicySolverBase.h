@@ -5,18 +5,41 @@
 #include "../SolverBase.h"
 #include "../../models/basic_model_objects/SolutionRealization.h"
 
+#include <functional>
+#include <vector>
+
 namespace solvers {
 
 class AROPolicySolverBase : public solvers::SolverBase {
+public:
+    // true if the policy of the decision may depend on the uncertainty variable, which is one of its dependencies
+    using DependencyPattern = std::function<bool(robust_model::DecisionVariable const&,
+                                                 robust_model::UncertaintyVariable const&)>;
+
 public:
     explicit AROPolicySolverBase(robust_model::ROModel const& model);
     virtual robust_model::SolutionRealization specific_solution(std::vector<double> const& uncertainty_realization) const = 0;
 
+    // Limits the policy of a decision to the uncertainty variables of its last periods, the period of the decision
+    // included. Decisions and uncertainty variables without period keep their dependencies.
+    // Replaces a dependency pattern and has to be set before building.
+    void set_dependency_window(robust_model::period_id periods);
+
+    // Limits the policies to the dependencies accepted by the pattern, has to be set before building.
+    void set_dependency_pattern(DependencyPattern const& pattern);
+
+    DependencyPattern const& dependency_pattern() const;
+
 protected:
     robust_model::ROModel const& model() const;
 
+    // the dependencies of the decision, which the dependency pattern accepts
+    std::vector<robust_model::UncertaintyVariable::Reference>
+    policy_dependencies(robust_model::DecisionVariable const& dvar) const;
+
 private:
     robust_model::ROModel const& _model;
+    DependencyPattern _dependency_pattern;
 };
 
 }
@@ -1,6 +1,16 @@
 #include "AffineAdjustablePolicySolver.h"
 #include "../../helpers/helpers.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <tuple>
+
 namespace robust_model {
 
 AffineAdjustablePolicySolver::AffineAdjustablePolicySolver(ROModel const& model) :
@@ -8,22 +18,22 @@ AffineAdjustablePolicySolver::AffineAdjustablePolicySolver(ROModel const& model)
         _soc_model("AARC of " + model.name()) {}
 
 
-void AffineAdjustablePolicySolver::add_ro_constraint(ROModel::RoConstraint const& ro_constr) {
+void AffineAdjustablePolicySolver::add_ro_constraint(CounterpartTarget& target, ROModel::RoConstraint const& ro_constr) {
     switch (ro_constr.sense()) {
         case ConstraintSense::GEQ: {
-            auto dual_objective = add_counterpart_constraints_for_minimization(ro_constr.expression(),
+            auto dual_objective = add_counterpart_constraints_for_minimization(target, ro_constr.expression(),
                                                                                ro_constr.name());
-            soc_model().add_constraint(dual_objective >= 0, ro_constr.name() + "RC");
+            target.model.add_constraint(dual_objective >= 0, ro_constr.name() + "RC");
             return;
         }
         case ConstraintSense::LEQ: {
-            auto dual_objective = add_counterpart_constraints_for_minimization(-ro_constr.expression(),
+            auto dual_objective = add_counterpart_constraints_for_minimization(target, -ro_constr.expression(),
                                                                                ro_constr.name());
-            soc_model().add_constraint(dual_objective >= 0, ro_constr.name() + "RC");
+            target.model.add_constraint(dual_objective >= 0, ro_constr.name() + "RC");
             return;
         }
         case ConstraintSense::EQ: {
-            add_rc_constraints_for_equality(ro_constr.expression(), ro_constr.name());
+            add_rc_constraints_for_equality(target, ro_constr.expression(), ro_constr.name());
             return;
         }
         default:
@@ -32,103 +42,331 @@ void AffineAdjustablePolicySolver::add_ro_constraint(ROModel::RoConstraint const
 }
 
 AffineExpression<SOCVariable::Reference>
-AffineAdjustablePolicySolver::add_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
+AffineAdjustablePolicySolver::add_counterpart_constraints_for_minimization(CounterpartTarget& target,
+                                                                           RoAffineExpression const& expr,
                                                                            std::string const& name_addendum) {
     switch (expr.uncertainty_behaviour()) {
         case RoAffineExpression::UncertaintyBehaviour::MULTI_AVERAGE:
         case RoAffineExpression::UncertaintyBehaviour::MULTI_UNION:
-            return add_robust_counterpart_constraints_for_minimization(expr, name_addendum);
+            if (_closed_form_set_type != UncertaintySet::SpecialSetType::OTHER) {
+                return add_closed_form_counterpart_constraints_for_minimization(target, expr, name_addendum);
+            }
+            return add_robust_counterpart_constraints_for_minimization(target, expr, name_addendum);
         case RoAffineExpression::UncertaintyBehaviour::STOCHASTIC:
-            return add_stochastic_counterpart_constraints_for_minimization(expr, name_addendum);
+            return add_stochastic_counterpart_constraints_for_minimization(expr);
     }
 }
 
 AffineExpression<SOCVariable::Reference>
-AffineAdjustablePolicySolver::add_robust_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
+AffineAdjustablePolicySolver::add_robust_counterpart_constraints_for_minimization(CounterpartTarget& target,
+                                                                                  RoAffineExpression const& expr,
                                                                                   std::string const& name_addendum) {
-    auto const epigraph_var = soc_model().add_variable("EpiVar" + name_addendum);
-    AffineExpression<SOCVariable::Reference> average; // this is only needed for average and not union behaviour!
-    for (auto const uncertainty_union_set: model().uncertainty_set().constraint_sets()) {
-        AffineExpression<SOCVariable::Reference> dual_objective;
-        std::vector<AffineExpression<SOCVariable::Reference>> dual_constraint_expressions(model().num_uvars());
-
-        add_dual_of_uncertainty_set(dual_objective, dual_constraint_expressions, uncertainty_union_set, name_addendum);
-        add_dual_of_expression(dual_objective, dual_constraint_expressions, expr);
-
-
-        for (auto const& var: model().uncertainty_variables()) {
-            soc_model().add_constraint(dual_constraint_expressions[var.id().raw_id()] == 0,
-                                       name_addendum + "_DualConstr_" + var.name());
+    auto const epigraph_var = target.model.add_variable("EpiVar" + name_addendum);
+    auto const& union_sets = model().uncertainty_set().constraint_sets();
+    if (_constraint_generation and union_sets.size() > 1 and
+        expr.uncertainty_behaviour() == RoAffineExpression::UncertaintyBehaviour::MULTI_UNION) {
+        GeneratedCounterpart counterpart{expr, name_addendum, epigraph_var, std::vector<bool>(union_sets.size(), false)};
+        for (size_t i = 0; i < union_sets.size(); ++i) {
+            if (i == 0 or not union_sets[i]->is_box()) {
+                add_generated_uncertainty_set(target, counterpart, i);
+            }
         }
+        target.generated_counterparts.emplace_back(std::move(counterpart));
+        return AffineExpression<SOCVariable::Reference>(epigraph_var);
+    }
+    AffineExpression<SOCVariable::Reference> average; // this is only needed for average and not union behaviour!
+    for (auto const uncertainty_union_set: union_sets) {
+        auto const dual_objective = add_dual_counterpart(target, expr, uncertainty_union_set, name_addendum);
         if (expr.uncertainty_behaviour() == RoAffineExpression::UncertaintyBehaviour::MULTI_UNION) {
-            soc_model().add_constraint(epigraph_var <= dual_objective,
-                                       "EpiConstr" + name_addendum + "_US" +
-                                       std::to_string(uncertainty_union_set.raw_id()));
+            add_epigraph_constraint(target, epigraph_var, dual_objective, 1.,
+                                    "EpiConstr" + name_addendum + "_US" +
+                                    std::to_string(uncertainty_union_set.raw_id()));
         }
         if (expr.uncertainty_behaviour() == RoAffineExpression::UncertaintyBehaviour::MULTI_AVERAGE) {
             average += dual_objective;
         }
     }
     if (expr.uncertainty_behaviour() == RoAffineExpression::UncertaintyBehaviour::MULTI_AVERAGE) {
-        average /= double(model().uncertainty_set().constraint_sets().size());
-        soc_model().add_constraint(epigraph_var <= average,
-                                   "EpiConstr" + name_addendum + "_AVG");
+        add_epigraph_constraint(target, epigraph_var, average,
+                                1. / double(union_sets.size()),
+                                "EpiConstr" + name_addendum + "_AVG");
     }
     return AffineExpression<SOCVariable::Reference>(epigraph_var);
 }
 
 AffineExpression<SOCVariable::Reference>
-AffineAdjustablePolicySolver::add_stochastic_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
+AffineAdjustablePolicySolver::add_dual_counterpart(CounterpartTarget& target, RoAffineExpression const& expr,
+                                                   UncertaintySetConstraintsSet::Index const union_set_constraints,
+                                                   std::string const& name_addendum) {
+    AffineExpression<SOCVariable::Reference> dual_objective;
+    std::vector<AffineExpression<SOCVariable::Reference>> dual_constraint_expressions(model().num_uvars());
+
+    add_dual_of_uncertainty_set(target, dual_objective, dual_constraint_expressions, union_set_constraints,
+                                name_addendum);
+    add_dual_of_expression(dual_objective, dual_constraint_expressions, expr);
+
+
+    for (auto const& var: model().uncertainty_variables()) {
+        target.dual_constraints.emplace_back(var.id().raw_id(), target.model.soc_constraints().size());
+        target.model.add_constraint(dual_constraint_expressions[var.id().raw_id()] == 0,
+                                    name_addendum + "_DualConstr_" + var.name());
+    }
+    return dual_objective;
+}
+
+void AffineAdjustablePolicySolver::add_generated_uncertainty_set(CounterpartTarget& target,
+                                                                 GeneratedCounterpart& counterpart,
+                                                                 size_t const set_position) {
+    auto const union_set = model().uncertainty_set().constraint_sets().at(set_position);
+    auto const dual_objective = add_dual_counterpart(target, counterpart.expr, union_set, counterpart.name_addendum);
+    add_epigraph_constraint(target, counterpart.epigraph_var, dual_objective, 1.,
+                            "EpiConstr" + counterpart.name_addendum + "_US" + std::to_string(union_set.raw_id()));
+    counterpart.active_sets[set_position] = true;
+}
+
+size_t AffineAdjustablePolicySolver::add_violated_uncertainty_sets() {
+    auto const boxes = uncertainty_set_boxes();
+    std::vector<std::optional<size_t>> violated_sets(_generated_counterparts.size());
+    std::atomic<size_t> next_counterpart = 0;
+    auto const find_violated_sets = [&]() {
+        for (size_t i = next_counterpart++; i < _generated_counterparts.size(); i = next_counterpart++) {
+            violated_sets[i] = most_violated_uncertainty_set(_generated_counterparts[i], boxes);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(build_threads(), _generated_counterparts.size()); ++i) {
+        threads.emplace_back(find_violated_sets);
+    }
+    find_violated_sets();
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    CounterpartTarget target{soc_model()};
+    size_t added_sets = 0;
+    for (size_t i = 0; i < _generated_counterparts.size(); ++i) {
+        if (violated_sets[i]) {
+            add_generated_uncertainty_set(target, _generated_counterparts[i], violated_sets[i].value());
+            ++added_sets;
+        }
+    }
+    std::move(target.parametric_coefficients.begin(), target.parametric_coefficients.end(),
+              std::back_inserter(_parametric_coefficients));
+    std::move(target.dual_constraints.begin(), target.dual_constraints.end(), std::back_inserter(_dual_constraints));
+    return added_sets;
+}
+
+std::optional<size_t>
+AffineAdjustablePolicySolver::most_violated_uncertainty_set(GeneratedCounterpart const& counterpart,
+                                                            std::vector<std::optional<Box>> const& boxes) const {
+    // the epigraph variable has to stay below the minimum of the expression over every set
+    auto const [coefficients, constant] = policy_coefficients(counterpart.expr);
+    double const epigraph_value = counterpart.epigraph_var->solution();
+    std::optional<size_t> most_violated;
+    double largest_violation = _constraint_generation_tolerance;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (counterpart.active_sets[i] or not boxes[i]) {
+            continue;
+        }
+        auto const& [lbs, ubs] = boxes[i].value();
+        // empty boxes do not restrict the expression
+        bool empty = false;
+        double minimum = constant;
+        for (size_t u = 0; u < coefficients.size(); ++u) {
+            empty = empty or lbs[u] > ubs[u];
+            if (coefficients[u] != 0) {
+                minimum += coefficients[u] * (coefficients[u] > 0 ? lbs[u] : ubs[u]);
+            }
+        }
+        if (not empty and epigraph_value - minimum > largest_violation) {
+            largest_violation = epigraph_value - minimum;
+            most_violated = i;
+        }
+    }
+    return most_violated;
+}
+
+std::vector<std::optional<AffineAdjustablePolicySolver::Box>>
+AffineAdjustablePolicySolver::uncertainty_set_boxes() const {
+    std::vector<std::optional<Box>> boxes;
+    for (auto const union_set: model().uncertainty_set().constraint_sets()) {
+        if (not union_set->is_box()) {
+            boxes.emplace_back();
+            continue;
+        }
+        Box box(model().uncertainty_set().lower_bounds(), model().uncertainty_set().upper_bounds());
+        for (auto const& constr: union_set->constraints()) {
+            // u + constant (sense) 0
+            auto const& affine = constr.soc_expression().affine();
+            size_t const u = affine.linear().scaled_variables().front().variable().raw_id();
+            if (constr.sense() != ConstraintSense::LEQ) {
+                box.first[u] = std::max(box.first[u], -affine.constant());
+            }
+            if (constr.sense() != ConstraintSense::GEQ) {
+                box.second[u] = std::min(box.second[u], -affine.constant());
+            }
+        }
+        boxes.emplace_back(std::move(box));
+    }
+    return boxes;
+}
+
+std::pair<std::vector<double>, double>
+AffineAdjustablePolicySolver::policy_coefficients(RoAffineExpression const& expr) const {
+    std::vector<double> coefficients(model().num_uvars(), 0.);
+    double constant = expr.constant();
+    for (auto const& suvar: expr.uncertainties().scaled_variables()) {
+        coefficients[suvar.variable().raw_id()] += suvar.scale();
+    }
+    for (auto const& sdvar: expr.decisions().scaled_variables()) {
+        auto const& dvar_dependencies = dependencies(sdvar.variable());
+        for (size_t i = 0; i < dvar_dependencies.size(); ++i) {
+            coefficients[dvar_dependencies[i].raw_id()] +=
+                    sdvar.scale() * adjustable_factors(sdvar.variable()).at(i)->solution();
+        }
+        constant += sdvar.scale() * adjustable_constant(sdvar.variable())->solution();
+    }
+    for (auto const& usdvar: expr.uncertainty_decisions().scaled_variables()) {
+        coefficients[usdvar.variable().uncertainty_variable().raw_id()] +=
+                usdvar.scale() * adjustable_constant(usdvar.variable().decision_variable())->solution();
+    }
+    return {coefficients, constant};
+}
+
+AffineExpression<SOCVariable::Reference>
+AffineAdjustablePolicySolver::add_closed_form_counterpart_constraints_for_minimization(CounterpartTarget& target,
+                                                                                      RoAffineExpression const& expr,
                                                                                       std::string const& name_addendum) {
-    auto const adjustable_factors_scales = model().expectation_provider().expected_value(
-            [&](UncertaintyRealization const& realization) {
-                std::vector<std::vector<double>> factors(model().num_dvars(),
-                                                         std::vector<double>(model().num_uvars(), 0.));
-                for (auto const& svar: expr.decisions().scaled_variables()) {
-                    for (auto const& uvar: svar.variable()->dependencies()) {
-                        factors.at(svar.variable().raw_id()).at(uvar.raw_id()) +=
-                                svar.scale() * realization.value(uvar);
-                    }
-                }
-                for (auto const& svar: expr.uncertainty_decisions().scaled_variables()) {
-                    for (auto const& uvar: svar.variable().decision_variable()->dependencies()) {
-                        factors.at(svar.variable().decision_variable().raw_id()).at(uvar.raw_id()) +=
-                                svar.scale() *
-                                realization.value(uvar) *
-                                realization.value(svar.variable().uncertainty_variable());
-                    }
-                }
-                return factors;
-            });
-    auto const adjustable_constants_scales = model().expectation_provider().expected_value(
-            [&](UncertaintyRealization const& realization) {
-                std::vector<double> factors(model().num_dvars(), 0.);
-                for (auto const& svar: expr.decisions().scaled_variables()) {
-                    factors.at(svar.variable().raw_id()) +=
-                            svar.scale();
-                }
-                for (auto const& svar: expr.uncertainty_decisions().scaled_variables()) {
-                    factors.at(svar.variable().decision_variable().raw_id()) +=
-                            svar.scale() *
-                            realization.value(svar.variable().uncertainty_variable());
-                }
-                return factors;
-            });
+    // the counterpart is epigraph_var <= min_u coefficients^T u + dual_objective over the single uncertainty set
+    auto const epigraph_var = target.model.add_variable("EpiVar" + name_addendum);
+    AffineExpression<SOCVariable::Reference> dual_objective;
+    std::vector<AffineExpression<SOCVariable::Reference>> coefficients(model().num_uvars());
+    add_dual_of_expression(dual_objective, coefficients, expr);
+    if (_closed_form_set_type == UncertaintySet::SpecialSetType::BOX) {
+        add_closed_form_of_box(target, dual_objective, coefficients, name_addendum);
+    } else {
+        add_closed_form_of_norm_ball(target, dual_objective, coefficients, name_addendum);
+    }
+    add_epigraph_constraint(target, epigraph_var, dual_objective, 1.,
+                            "EpiConstr" + name_addendum + "_" + UncertaintySet::to_string(_closed_form_set_type));
+    return AffineExpression<SOCVariable::Reference>(epigraph_var);
+}
+
+void
+AffineAdjustablePolicySolver::add_closed_form_of_box(CounterpartTarget& target,
+                                                     AffineExpression<SOCVariable::Reference>& dual_objective,
+                                                     std::vector<AffineExpression<SOCVariable::Reference>> const& coefficients,
+                                                     std::string const& name_addendum) {
+    // min_{lb <= u <= ub} c^T u = c^T center - ||radius * c||_1
+    std::vector<AffineExpression<SOCVariable::Reference>> deviations;
+    for (auto const& var: model().uncertainty_variables()) {
+        auto const& coefficient = coefficients[var.id().raw_id()];
+        dual_objective += 0.5 * (var.lb() + var.ub()) * coefficient;
+        if (var.ub() > var.lb()) {
+            deviations.push_back(0.5 * (var.ub() - var.lb()) * coefficient);
+        }
+    }
+    if (deviations.empty()) {
+        return;
+    }
+    auto const dv = target.model.add_variable(name_addendum + "_Box_DVar", 0, NO_VARIABLE_UB);
+    dual_objective += -1. * dv;
+    target.model.add_constraint(SOCExpression<SOCVariable>::norm(deviations, VectorNormType::One) <= dv,
+                                name_addendum + "_Box_SOC");
+}
+
+void
+AffineAdjustablePolicySolver::add_closed_form_of_norm_ball(CounterpartTarget& target,
+                                                           AffineExpression<SOCVariable::Reference>& dual_objective,
+                                                           std::vector<AffineExpression<SOCVariable::Reference>>& coefficients,
+                                                           std::string const& name_addendum) {
+    // min_{||u|| <= budget, lb <= u <= ub} c^T u is the dual with the bound multipliers lbd and ubd
+    // and the norm multiplier dv >= ||c + lbd + ubd||_*, the dual constraints are substituted into the norm
+    for (auto const& var: model().uncertainty_variables()) {
+        auto& coefficient = coefficients[var.id().raw_id()];
+        if (var.lb() != NO_VARIABLE_LB) {
+            auto const lbd = target.model.add_variable(name_addendum + "_LBD_" + var.name(), NO_VARIABLE_LB, 0);
+            dual_objective += -var.lb() * lbd;
+            coefficient += 1 * lbd;
+            add_parametric_coefficient(target,
+                                       [this, id = var.id()]() { return model().uncertainty_variables()[id.raw_id()].lb(); },
+                                       lbd, -1.);
+        }
+        if (var.ub() != NO_VARIABLE_UB) {
+            auto const ubd = target.model.add_variable(name_addendum + "_UBD_" + var.name(), 0, NO_VARIABLE_UB);
+            dual_objective += -var.ub() * ubd;
+            coefficient += 1 * ubd;
+            add_parametric_coefficient(target,
+                                       [this, id = var.id()]() { return model().uncertainty_variables()[id.raw_id()].ub(); },
+                                       ubd, -1.);
+        }
+    }
+    auto const& constr = model().uncertainty_set().uncertainty_constraints().front();
+    auto const dv = target.model.add_variable(name_addendum + "_" + constr.name() + "_DVar", constr.dual_lb(),
+                                              constr.dual_ub());
+    dual_objective += constr.soc_expression().affine().constant() * dv;
+    add_parametric_coefficient(target, [this]() {
+        return model().uncertainty_set().uncertainty_constraints().front().soc_expression().affine().constant();
+    }, dv, 1.);
+    target.model.add_constraint(
+            SOCExpression<SOCVariable>::norm(coefficients,
+                                             dual_norm_type(constr.soc_expression().normed_vector().norm_type())) <= dv,
+            name_addendum + constr.name() + "_Dual_SOC");
+}
+
+AffineExpression<SOCVariable::Reference>
+AffineAdjustablePolicySolver::add_stochastic_counterpart_constraints_for_minimization(RoAffineExpression const& expr) {
+    // the expectation is linear in the first and second moments of the realization, which are cached by the provider
+    auto const& expectation_provider = model().expectation_provider();
+    auto const& means = expectation_provider.first_moments();
+    std::vector<std::pair<size_t, size_t>> moment_pairs;
+    for (auto const& svar: expr.uncertainty_decisions().scaled_variables()) {
+        for (auto const& uvar: dependencies(svar.variable().decision_variable())) {
+            moment_pairs.emplace_back(uvar.raw_id(), svar.variable().uncertainty_variable().raw_id());
+        }
+    }
+    auto const second_moments = expectation_provider.second_moments(moment_pairs);
+
+    // expected scales of the adjustable factors and of the adjustable constant of each decision variable
+    std::map<size_t, std::pair<std::vector<double>, double>> scales;
+    auto const dvar_scales = [&](DecisionVariable::Index const& dvar) -> std::pair<std::vector<double>, double>& {
+        auto& dvar_scale = scales[dvar.raw_id()];
+        dvar_scale.first.resize(dependencies(dvar).size(), 0.);
+        return dvar_scale;
+    };
+    for (auto const& svar: expr.decisions().scaled_variables()) {
+        auto& [factor_scales, constant_scale] = dvar_scales(svar.variable());
+        auto const& dvar_dependencies = dependencies(svar.variable());
+        for (size_t i = 0; i < dvar_dependencies.size(); ++i) {
+            factor_scales[i] += svar.scale() * means.at(dvar_dependencies[i].raw_id());
+        }
+        constant_scale += svar.scale();
+    }
+    size_t moment_pair = 0;
+    for (auto const& svar: expr.uncertainty_decisions().scaled_variables()) {
+        auto& [factor_scales, constant_scale] = dvar_scales(svar.variable().decision_variable());
+        for (size_t i = 0; i < factor_scales.size(); ++i) {
+            factor_scales[i] += svar.scale() * second_moments[moment_pair++];
+        }
+        constant_scale += svar.scale() * means.at(svar.variable().uncertainty_variable().raw_id());
+    }
+
     AffineExpression<SOCVariable::Reference> res_expr(expr.constant());
-    for (auto const& dvar: model().decision_variables()) {
-        for (auto const& uvar: model().uncertainty_variables()) {
-            if (adjustable_factors_scales.at(dvar.id().raw_id()).at(uvar.id().raw_id()) != 0)
-                res_expr += adjustable_factors_scales.at(dvar.id().raw_id()).at(uvar.id().raw_id()) *
-                            adjustable_factors(dvar.id()).at(uvar.id().raw_id());
+    for (auto const& [dvar_id, dvar_scale]: scales) {
+        auto const& dvar = model().decision_variables().at(dvar_id).id();
+        auto const& [factor_scales, constant_scale] = dvar_scale;
+        for (size_t i = 0; i < factor_scales.size(); ++i) {
+            if (factor_scales[i] != 0)
+                res_expr += factor_scales[i] * adjustable_factors(dvar).at(i);
         }
-        if (adjustable_constants_scales.at(dvar.id().raw_id()) != 0)
-            res_expr += adjustable_constants_scales.at(dvar.id().raw_id()) *
-                        adjustable_constant(dvar.id());
+        if (constant_scale != 0)
+            res_expr += constant_scale * adjustable_constant(dvar);
     }
     return res_expr;
 }
 
-void AffineAdjustablePolicySolver::add_rc_constraints_for_equality(RoAffineExpression const& expr,
+void AffineAdjustablePolicySolver::add_rc_constraints_for_equality(CounterpartTarget& target,
+                                                                   RoAffineExpression const& expr,
                                                                    std::string const& name_addendum) {
     helpers::exception_check(expr.uncertainty_behaviour() != RoAffineExpression::UncertaintyBehaviour::STOCHASTIC,
                              "Equality not yet allowed in stochastic case!"
@@ -140,84 +378,134 @@ void AffineAdjustablePolicySolver::add_rc_constraints_for_equality(RoAffineExpre
     }
     for (auto const& sdvar: expr.decisions().scaled_variables()) {
         adjustable_constants_equation += sdvar.scale() * adjustable_constant(sdvar.variable());
-        for (size_t i = 0; i < sdvar.variable()->dependencies().size(); ++i) {
-            adjustable_factor_equations[sdvar.variable()->dependencies()[i].raw_id()] +=
+        for (size_t i = 0; i < dependencies(sdvar.variable()).size(); ++i) {
+            adjustable_factor_equations[dependencies(sdvar.variable())[i].raw_id()] +=
                     sdvar.scale() * adjustable_factors(sdvar.variable()).at(i);
         }
     }
     for (auto const& usdvar: expr.uncertainty_decisions().scaled_variables()) {
-        helpers::exception_check(usdvar.variable().decision_variable()->dependencies().empty(),
+        helpers::exception_check(dependencies(usdvar.variable().decision_variable()).empty(),
                                  "Uncertainty Scaled Variables are not supported for recourse decisions");
         adjustable_factor_equations[usdvar.variable().decision_variable().raw_id()] +=
                 usdvar.scale() * adjustable_constant(usdvar.variable().decision_variable());
     }
     for (auto const& var: model().uncertainty_variables()) {
-        soc_model().add_constraint(adjustable_factor_equations[var.id().raw_id()] == 0,
+        target.model.add_constraint(adjustable_factor_equations[var.id().raw_id()] == 0,
                                    name_addendum + "_AffRC_" + var.name());
     }
-    soc_model().add_constraint(adjustable_constants_equation == 0, name_addendum + "_AffRC_" + "Base");
+    target.model.add_constraint(adjustable_constants_equation == 0, name_addendum + "_AffRC_" + "Base");
 }
 
 
 void
-AffineAdjustablePolicySolver::add_dual_of_uncertainty_set(AffineExpression<SOCVariable::Reference>& dual_objective,
+AffineAdjustablePolicySolver::add_dual_of_uncertainty_set(CounterpartTarget& target,
+                                                          AffineExpression<SOCVariable::Reference>& dual_objective,
                                                           std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
                                                           UncertaintySetConstraintsSet::Index const union_set_constraints,
                                                           std::string const& name_addendum) {
-    for (auto const& constr: model().uncertainty_set().uncertainty_constraints(union_set_constraints)) {
-        auto const dv = soc_model().add_variable(name_addendum + "_" + constr.name() + "_DVar", constr.dual_lb(),
-                                                 constr.dual_ub());
-        dual_objective += constr.soc_expression().affine().constant() * dv;
-        for (auto const& svar: constr.soc_expression().affine().linear().scaled_variables()) {
-            dual_constraint_expressions[svar.variable().raw_id()] += svar.scale() * dv;
+    auto const& dual_template = _uncertainty_set_dual_templates.at(union_set_constraints.raw_id());
+    std::vector<SOCVariable::Reference> multipliers;
+    multipliers.reserve(dual_template.multipliers.size());
+    for (auto const& multiplier: dual_template.multipliers) {
+        auto const dv = target.model.add_variable(name_addendum + multiplier.name, multiplier.lb, multiplier.ub);
+        multipliers.push_back(dv);
+        // blocks added by constraint generation after a parametric update need the current constant
+        dual_objective += (multiplier.parameter ? multiplier.parameter_scale * multiplier.parameter()
+                                                : multiplier.constant) * dv;
+        if (multiplier.parameter) {
+            add_parametric_coefficient(target, multiplier.parameter, dv, multiplier.parameter_scale);
         }
-        if (not constr.soc_expression().is_affine()) {
-            add_dual_of_normed_vector(constr.soc_expression().normed_vector(), dv,
-                                      dual_objective, dual_constraint_expressions,
-                                      name_addendum + constr.name());
+    }
+    for (size_t u = 0; u + 1 < dual_template.row_starts.size(); ++u) {
+        auto& lhs = dual_constraint_expressions[u];
+        for (size_t k = dual_template.row_starts[u]; k < dual_template.row_starts[u + 1]; ++k) {
+            lhs += dual_template.coefficients[k] * multipliers[dual_template.multiplier_indices[k]];
         }
     }
-
-    add_dual_of_uvar_bounds(dual_objective, dual_constraint_expressions, name_addendum);
+    for (auto const& cone: dual_template.cones) {
+        std::vector<SOCVariable::Reference> const dus(multipliers.begin() + cone.first_entry,
+                                                      multipliers.begin() + cone.first_entry + cone.size);
+        target.model.add_constraint(SOCExpression<SOCVariable>::norm(dus, cone.norm_type) <= multipliers[cone.multiplier],
+                                    name_addendum + cone.name);
+    }
 }
 
-void
-AffineAdjustablePolicySolver::add_dual_of_normed_vector(const NormedAffineVector<UncertaintyVariable>& normed_vector,
-                                                        SOCVariable::Reference dv,
-                                                        AffineExpression<SOCVariable::Reference>& dual_objective,
-                                                        std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
-                                                        const std::string& name_addendum) {
-    auto const dus = soc_model().add_variables(normed_vector.normed_vector().size(), name_addendum + "_DSVar",
-                                               NO_VARIABLE_LB, NO_VARIABLE_UB);
-    for (size_t i = 0; i < normed_vector.normed_vector().size(); ++i) {
-        auto const& affine = normed_vector.normed_vector().at(i);
-        auto const du = dus.at(i);
-        dual_objective += affine.constant() * du;
+AffineAdjustablePolicySolver::UncertaintySetDualTemplate
+AffineAdjustablePolicySolver::compile_uncertainty_set_dual_template(
+        UncertaintySetConstraintsSet::Index const union_set_constraints) const {
+    UncertaintySetDualTemplate dual_template;
+    // entries (uncertainty variable, multiplier, coefficient) of the constraint matrix
+    std::vector<std::tuple<size_t, size_t, double>> entries;
+    auto const add_multiplier = [&](std::string name, double lb, double ub, double constant) {
+        dual_template.multipliers.push_back({std::move(name), lb, ub, constant, {}, 0});
+        return dual_template.multipliers.size() - 1;
+    };
+    auto const add_entries = [&](auto const& affine, size_t multiplier) {
         for (auto const& svar: affine.linear().scaled_variables()) {
-            dual_constraint_expressions[svar.variable().raw_id()] += svar.scale() * du;
+            entries.emplace_back(svar.variable().raw_id(), multiplier, svar.scale());
+        }
+    };
+
+    auto const& constraints = model().uncertainty_set().uncertainty_constraints(union_set_constraints);
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        auto const& constr = constraints[i];
+        auto const& affine = constr.soc_expression().affine();
+        size_t const dv = add_multiplier("_" + constr.name() + "_DVar", constr.dual_lb(), constr.dual_ub(),
+                                         affine.constant());
+        dual_template.multipliers[dv].parameter = [this, union_set_constraints, i]() {
+            return model().uncertainty_set().uncertainty_constraints(union_set_constraints)[i]
+                    .soc_expression().affine().constant();
+        };
+        dual_template.multipliers[dv].parameter_scale = 1.;
+        add_entries(affine, dv);
+        if (not constr.soc_expression().is_affine()) {
+            auto const& normed_vector = constr.soc_expression().normed_vector();
+            auto const& normed_affines = normed_vector.normed_vector();
+            size_t const first_entry = dual_template.multipliers.size();
+            for (size_t j = 0; j < normed_affines.size(); ++j) {
+                add_entries(normed_affines[j],
+                            add_multiplier(constr.name() + "_DSVar_" + std::to_string(j), NO_VARIABLE_LB,
+                                           NO_VARIABLE_UB, normed_affines[j].constant()));
+            }
+            dual_template.cones.push_back({dv, first_entry, normed_affines.size(),
+                                           dual_norm_type(normed_vector.norm_type()),
+                                           constr.name() + "_Dual_SOC"});
         }
     }
-    soc_model().add_constraint(SOCExpression<SOCVariable>::norm(dus, dual_norm_type(normed_vector.norm_type())) <= dv,
-                               name_addendum + "_Dual_SOC");
-}
 
-void
-AffineAdjustablePolicySolver::add_dual_of_uvar_bounds(AffineExpression<SOCVariable::Reference>& dual_objective,
-                                                      std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
-                                                      std::string const& name_addendum) {
     for (auto const& var: model().uncertainty_variables()) {
-        auto& lhs = dual_constraint_expressions[var.id().raw_id()];
+        auto const id = var.id();
         if (var.lb() != NO_VARIABLE_LB) {
-            auto const dv = soc_model().add_variable(name_addendum + "_LBD_" + var.name(), NO_VARIABLE_LB, 0);
-            dual_objective += -var.lb() * dv;
-            lhs += 1 * dv;
+            size_t const dv = add_multiplier("_LBD_" + var.name(), NO_VARIABLE_LB, 0, -var.lb());
+            entries.emplace_back(id.raw_id(), dv, 1.);
+            dual_template.multipliers[dv].parameter = [this, id]() {
+                return model().uncertainty_variables()[id.raw_id()].lb();
+            };
+            dual_template.multipliers[dv].parameter_scale = -1.;
         }
         if (var.ub() != NO_VARIABLE_UB) {
-            auto const dv = soc_model().add_variable(name_addendum + "_UBD_" + var.name(), 0, NO_VARIABLE_UB);
-            dual_objective += -var.ub() * dv;
-            lhs += 1 * dv;
+            size_t const dv = add_multiplier("_UBD_" + var.name(), 0, NO_VARIABLE_UB, -var.ub());
+            entries.emplace_back(id.raw_id(), dv, 1.);
+            dual_template.multipliers[dv].parameter = [this, id]() {
+                return model().uncertainty_variables()[id.raw_id()].ub();
+            };
+            dual_template.multipliers[dv].parameter_scale = -1.;
         }
     }
+
+    // the stable sort keeps the multipliers of each dual constraint in the order of the uncertainty set
+    std::stable_sort(entries.begin(), entries.end(), [](auto const& first, auto const& second) {
+        return std::get<0>(first) < std::get<0>(second);
+    });
+    dual_template.row_starts.assign(model().num_uvars() + 1, 0);
+    for (auto const& [uvar, multiplier, coefficient]: entries) {
+        ++dual_template.row_starts[uvar + 1];
+        dual_template.multiplier_indices.push_back(multiplier);
+        dual_template.coefficients.push_back(coefficient);
+    }
+    std::partial_sum(dual_template.row_starts.begin(), dual_template.row_starts.end(),
+                     dual_template.row_starts.begin());
+    return dual_template;
 }
 
 void
@@ -228,14 +516,14 @@ AffineAdjustablePolicySolver::add_dual_of_expression(AffineExpression<SOCVariabl
         dual_constraint_expressions[suvar.variable().raw_id()] += suvar.scale();
     }
     for (auto const& sdvar: expr.decisions().scaled_variables()) {
-        for (size_t i = 0; i < sdvar.variable()->dependencies().size(); ++i) {
-            dual_constraint_expressions[sdvar.variable()->dependencies()[i].raw_id()] +=
+        for (size_t i = 0; i < dependencies(sdvar.variable()).size(); ++i) {
+            dual_constraint_expressions[dependencies(sdvar.variable())[i].raw_id()] +=
                     sdvar.scale() * adjustable_factors(sdvar.variable()).at(i);
         }
         dual_objective += sdvar.scale() * adjustable_constant(sdvar.variable());
     }
     for (auto const& usdvar: expr.uncertainty_decisions().scaled_variables()) {
-        helpers::exception_check(usdvar.variable().decision_variable()->dependencies().empty(),
+        helpers::exception_check(dependencies(usdvar.variable().decision_variable()).empty(),
                                  "Uncertainty Scaled Variables are not supported for recourse decisions");
         dual_constraint_expressions[usdvar.variable().decision_variable().raw_id()] +=
                 usdvar.scale() * adjustable_constant(usdvar.variable().decision_variable());
@@ -243,33 +531,255 @@ AffineAdjustablePolicySolver::add_dual_of_expression(AffineExpression<SOCVariabl
     dual_objective += expr.constant();
 }
 
+void AffineAdjustablePolicySolver::add_parametric_coefficient(CounterpartTarget& target,
+                                                              std::function<double()> const& parameter,
+                                                              SOCVariable::Reference dual_variable,
+                                                              double const scale) {
+    if (_parametric_uncertainty_set) {
+        target.open_parametric_coefficients.push_back({parameter, dual_variable, scale, parameter()});
+    }
+}
+
+void AffineAdjustablePolicySolver::add_epigraph_constraint(CounterpartTarget& target,
+                                                           SOCVariable::Reference epigraph_var,
+                                                           AffineExpression<SOCVariable::Reference> const& dual_objective,
+                                                           double const scale,
+                                                           std::string const& name) {
+    size_t const constraint_number = target.model.soc_constraints().size();
+    target.model.add_constraint(epigraph_var <= scale * dual_objective, name);
+    // the constraint is stored as epigraph_var - scale * dual_objective <= 0
+    for (auto& coefficient: target.open_parametric_coefficients) {
+        coefficient.scale *= -scale;
+        coefficient.constraint_number = constraint_number;
+        target.parametric_coefficients.emplace_back(std::move(coefficient));
+    }
+    target.open_parametric_coefficients.clear();
+}
+
 void AffineAdjustablePolicySolver::build_implementation() {
     build_variables();
+    _closed_form_set_type = closed_form_set_type();
+    if (_closed_form_set_type == UncertaintySet::SpecialSetType::OTHER) {
+        build_uncertainty_set_dual_templates();
+    }
     build_objective();
     build_constraints();
-    _soc_solver = std::make_unique<solvers::GurobiSOCSolver>(soc_model());
+}
+
+void AffineAdjustablePolicySolver::update_implementation() {
+    std::map<size_t, std::vector<std::pair<SOCVariable::Reference, double>>> changed_coefficients;
+    for (auto& coefficient: _parametric_coefficients) {
+        double const parameter = coefficient.parameter();
+        if (parameter == coefficient.last_parameter) {
+            continue;
+        }
+        helpers::exception_check(std::isfinite(parameter), "Parametric uncertainty set bounds have to stay finite!");
+        changed_coefficients[coefficient.constraint_number].emplace_back(coefficient.dual_variable,
+                                                                         coefficient.scale * parameter);
+        coefficient.last_parameter = parameter;
+    }
+    for (auto const& [constraint_number, coefficients]: changed_coefficients) {
+        soc_model().set_coefficients(constraint_number, coefficients);
+    }
+    // the kept objective values belong to the old uncertainty sets
+    if (not changed_coefficients.empty()) {
+        relax_lexicographic_constraints();
+    }
+}
+
+void AffineAdjustablePolicySolver::set_parametric_uncertainty_set(bool const parametric) {
+    helpers::exception_check(not built(), "Parametric uncertainty sets have to be declared before building!");
+    _parametric_uncertainty_set = parametric;
+}
+
+bool AffineAdjustablePolicySolver::parametric_uncertainty_set() const {
+    return _parametric_uncertainty_set;
+}
+
+void AffineAdjustablePolicySolver::set_constraint_generation(bool const constraint_generation) {
+    helpers::exception_check(not built(), "Constraint generation has to be set before building!");
+    _constraint_generation = constraint_generation;
+}
+
+bool AffineAdjustablePolicySolver::constraint_generation() const {
+    return _constraint_generation;
+}
+
+void AffineAdjustablePolicySolver::set_constraint_generation_tolerance(double const tolerance) {
+    helpers::exception_check(tolerance >= 0, "The constraint generation tolerance has to be nonnegative!");
+    _constraint_generation_tolerance = tolerance;
+}
+
+double AffineAdjustablePolicySolver::constraint_generation_tolerance() const {
+    return _constraint_generation_tolerance;
+}
+
+std::optional<std::vector<double>> AffineAdjustablePolicySolver::uncertainty_sensitivities() const {
+    helpers::exception_check(has_solution(), "Sensitivities are only known, when a solution exists!");
+    // the closed form counterparts do not dualize the uncertainty variables row by row
+    if (_dual_constraints.empty()) {
+        return {};
+    }
+    std::vector<double> sensitivities(model().num_uvars(), 0.);
+    for (auto const& [uvar, constraint_number]: _dual_constraints) {
+        auto const& constr = _soc_model.soc_constraints().at(constraint_number);
+        if (not constr.has_dual_value()) {
+            return {};
+        }
+        sensitivities.at(uvar) += std::abs(constr.dual_value());
+    }
+    return sensitivities;
+}
+
+void AffineAdjustablePolicySolver::set_lexicographic_reoptimization(bool const lexicographic) {
+    _lexicographic_reoptimization = lexicographic;
+}
+
+bool AffineAdjustablePolicySolver::lexicographic_reoptimization() const {
+    return _lexicographic_reoptimization;
+}
+
+void AffineAdjustablePolicySolver::set_lexicographic_tolerance(double const tolerance) {
+    helpers::exception_check(tolerance >= 0, "The lexicographic tolerance has to be nonnegative!");
+    _lexicographic_tolerance = tolerance;
+}
+
+double AffineAdjustablePolicySolver::lexicographic_tolerance() const {
+    return _lexicographic_tolerance;
 }
 
 void AffineAdjustablePolicySolver::solve_implementation() {
+    // the backend is only known once all parameters are set, it is kept for reoptimizations, until another
+    // backend or presolve is selected
+    if (not _soc_solver or _soc_solver_backend != soc_backend() or _soc_solver_presolve != soc_presolve()) {
+        _soc_solver = solvers::SOCSolverBase::create(soc_backend(), soc_model(), soc_presolve());
+        _soc_solver_backend = soc_backend();
+        _soc_solver_presolve = soc_presolve();
+    }
     set_parameters_to_other(soc_solver());
+    if (_lexicographic_reoptimization and soc_model().is_multi_objective()) {
+        solve_lexicographically();
+        return;
+    }
+    double const runtime = solve_soc_model();
+    set_results_from_other(soc_solver());
+    if (has_solution()) {
+        set_runtime(runtime);
+    }
+}
+
+double AffineAdjustablePolicySolver::solve_soc_model() {
     soc_solver().solve();
+    double runtime = soc_solver().runtime();
+    size_t round = 0;
+    while (not _generated_counterparts.empty() and soc_solver().status() == Status::OPTIMAL and
+           not cancel_requested()) {
+        size_t const added_sets = add_violated_uncertainty_sets();
+        if (added_sets == 0) {
+            break;
+        }
+        helpers::global_logger << "Constraint generation round " + std::to_string(++round) + " added "
+                                  + std::to_string(added_sets) + " uncertainty sets";
+        soc_solver().solve();
+        runtime += soc_solver().runtime();
+    }
+    return runtime;
+}
+
+void AffineAdjustablePolicySolver::solve_lexicographically() {
+    auto const objectives = soc_model().objectives();
+    double runtime = 0;
+    // the last objective is never kept, so at least one objective is solved
+    for (size_t i = _lexicographic_objectives; i < objectives.size(); ++i) {
+        soc_model().clear_and_set_objective(objectives[i]);
+        runtime += solve_soc_model();
+        if (soc_solver().status() != Status::OPTIMAL) {
+            helpers::warning_check(false, "Lexicographic reoptimization stopped at objective " + std::to_string(i)
+                                          + " without optimal solution!");
+            break;
+        }
+        helpers::global_logger << "Lexicographic objective " + std::to_string(i) + " has value "
+                                  + std::to_string(soc_solver().objective_value());
+        if (i + 1 == objectives.size() or cancel_requested()) {
+            break;
+        }
+        add_lexicographic_constraint(objectives[i], soc_solver().objective_value());
+        ++_lexicographic_objectives;
+    }
+    soc_model().clear_and_set_objective(objectives.front());
+    for (size_t i = 1; i < objectives.size(); ++i) {
+        soc_model().add_objective(objectives[i]);
+    }
     set_results_from_other(soc_solver());
+    if (has_solution()) {
+        set_runtime(runtime);
+        set_objective_value(objectives.front().expression().value(soc_solver()));
+    }
+}
+
+void AffineAdjustablePolicySolver::add_lexicographic_constraint(SOCModel::Objective const& objective,
+                                                                double const value) {
+    double const slack = _lexicographic_tolerance * std::max(1., std::abs(value));
+    bool const minimize = objective.sense() == ObjectiveSense::MIN;
+    double const bound = minimize ? value + slack : value - slack;
+    // a constraint relaxed by an update is tightened again
+    if (_lexicographic_objectives < _lexicographic_constraints.size()) {
+        soc_model().set_coefficients(_lexicographic_constraints[_lexicographic_objectives],
+                                     {{_lexicographic_one.value(), -bound},
+                                      {_lexicographic_relaxation.value(), 0}});
+        return;
+    }
+    if (not _lexicographic_one) {
+        _lexicographic_one = soc_model().add_variable("Lexicographic_One", 1, 1);
+        _lexicographic_relaxation = soc_model().add_variable("Lexicographic_Relaxation", 0, NO_VARIABLE_UB);
+    }
+    std::string const name = "Lexicographic_" + std::to_string(_lexicographic_objectives);
+    _lexicographic_constraints.push_back(soc_model().soc_constraints().size());
+    if (minimize) {
+        soc_model().add_constraint(objective.expression() <= bound * _lexicographic_one.value(), name);
+    } else {
+        soc_model().add_constraint(objective.expression() >= bound * _lexicographic_one.value(), name);
+    }
+}
+
+void AffineAdjustablePolicySolver::relax_lexicographic_constraints() {
+    auto const& objectives = soc_model().objectives();
+    for (size_t i = 0; i < _lexicographic_objectives; ++i) {
+        double const direction = objectives[i].sense() == ObjectiveSense::MIN ? -1 : 1;
+        soc_model().set_coefficients(_lexicographic_constraints[i],
+                                     {{_lexicographic_relaxation.value(), direction}});
+    }
+    _lexicographic_objectives = 0;
 }
 
 AffineSolution AffineAdjustablePolicySolver::affine_solution(DecisionVariable::Index const dvar) const {
     std::map<UncertaintyVariable::Index, double> dependent_scales;
     auto const& factors = adjustable_factors(dvar);
-    auto const& dependencies = dvar->dependencies();
-    for (size_t i = 0; i < dvar->dependencies().size(); ++i) {
-        dependent_scales[dependencies.at(i)] = factors.at(i)->solution();
+    auto const& dvar_dependencies = dependencies(dvar);
+    for (size_t i = 0; i < dvar_dependencies.size(); ++i) {
+        dependent_scales[dvar_dependencies.at(i)] = factors.at(i)->solution();
     }
     return AffineSolution(adjustable_constant(dvar)->solution(), dependent_scales);
 }
 
+void AffineAdjustablePolicySolver::set_start_policy(DecisionVariable::Index const dvar, AffineSolution const& policy) {
+    helpers::exception_check(built(), "Start policies can only be set for a built model!");
+    std::vector<std::pair<SOCVariable::Reference, double>> start_values = {{adjustable_constant(dvar),
+                                                                            policy.constant()}};
+    auto const& factors = adjustable_factors(dvar);
+    auto const& dvar_dependencies = dependencies(dvar);
+    for (size_t i = 0; i < dvar_dependencies.size(); ++i) {
+        auto const scale = policy.dependent_scales().find(dvar_dependencies[i]);
+        start_values.emplace_back(factors[i], scale != policy.dependent_scales().end() ? scale->second : 0.);
+    }
+    soc_model().set_start_values(start_values);
+}
+
 void AffineAdjustablePolicySolver::build_variables() {
     for (auto const& var: model().decision_variables()) {
+        _dependencies.emplace_back(policy_dependencies(var));
         _adjustable_factors.emplace_back();
-        for (auto const dependency: var.dependencies()) {
+        for (auto const dependency: dependencies(var.id())) {
             _adjustable_factors.back().emplace_back(
                     soc_model().add_variable("AV_" + var.name() + dependency->name(), NO_VARIABLE_LB, NO_VARIABLE_UB));
         }
@@ -279,43 +789,138 @@ void AffineAdjustablePolicySolver::build_variables() {
     }
 }
 
-void AffineAdjustablePolicySolver::build_constraints() {
-    for (auto const& constr: model().constraints()) {
-        add_ro_constraint(constr);
+void AffineAdjustablePolicySolver::build_uncertainty_set_dual_templates() {
+    for (auto const union_set_constraints: model().uncertainty_set().constraint_sets()) {
+        size_t const id = union_set_constraints.raw_id();
+        _uncertainty_set_dual_templates.resize(std::max(_uncertainty_set_dual_templates.size(), id + 1));
+        _uncertainty_set_dual_templates[id] = compile_uncertainty_set_dual_template(union_set_constraints);
     }
+}
+
+UncertaintySet::SpecialSetType AffineAdjustablePolicySolver::closed_form_set_type() const {
+    auto const set_type = model().uncertainty_set().special_type();
+    // the bounds of a box enter the closed form as coefficients of the norm, which are no parameters
+    if (set_type == UncertaintySet::SpecialSetType::BOX and _parametric_uncertainty_set) {
+        return UncertaintySet::SpecialSetType::OTHER;
+    }
+    return set_type;
+}
+
+void AffineAdjustablePolicySolver::build_constraints() {
+    std::vector<ROModel::RoConstraint> ro_constraints(model().constraints().begin(), model().constraints().end());
     for (auto const& var: model().decision_variables()) {
         if (var.lb() != NO_VARIABLE_LB) {
-            add_ro_constraint({var.reference() >= var.lb(), "LB_" + var.name()});
+            ro_constraints.emplace_back(var.reference() >= var.lb(), "LB_" + var.name());
         }
         if (var.ub() != NO_VARIABLE_UB) {
-            add_ro_constraint({var.reference() <= var.ub(), "UB_" + var.name()});
+            ro_constraints.emplace_back(var.reference() <= var.ub(), "UB_" + var.name());
         }
     }
+    if (build_threads() > 1 and ro_constraints.size() > 1) {
+        build_constraints_in_parallel(ro_constraints);
+        return;
+    }
+    CounterpartTarget target{soc_model()};
+    for (auto const& constr: ro_constraints) {
+        add_ro_constraint(target, constr);
+    }
+    std::move(target.parametric_coefficients.begin(), target.parametric_coefficients.end(),
+              std::back_inserter(_parametric_coefficients));
+    std::move(target.generated_counterparts.begin(), target.generated_counterparts.end(),
+              std::back_inserter(_generated_counterparts));
+    std::move(target.dual_constraints.begin(), target.dual_constraints.end(), std::back_inserter(_dual_constraints));
+}
+
+void AffineAdjustablePolicySolver::build_constraints_in_parallel(std::vector<ROModel::RoConstraint> const& ro_constraints) {
+    // the fragments are spliced in the order of the constraints, so that the soc model is the same as in a
+    // sequential build, independent of the number of threads
+    std::vector<std::unique_ptr<SOCModel>> fragments(ro_constraints.size());
+    std::vector<std::vector<ParametricCoefficient>> fragment_coefficients(ro_constraints.size());
+    std::vector<std::vector<GeneratedCounterpart>> fragment_counterparts(ro_constraints.size());
+    std::vector<std::vector<std::pair<size_t, size_t>>> fragment_dual_constraints(ro_constraints.size());
+    std::vector<std::exception_ptr> errors(ro_constraints.size());
+    std::atomic<size_t> next_constraint = 0;
+    auto const build_fragments = [&]() {
+        for (size_t i = next_constraint++; i < ro_constraints.size(); i = next_constraint++) {
+            try {
+                fragments[i] = std::make_unique<SOCModel>(soc_model().name() + "_" + ro_constraints[i].name());
+                CounterpartTarget target{*fragments[i]};
+                add_ro_constraint(target, ro_constraints[i]);
+                fragment_coefficients[i] = std::move(target.parametric_coefficients);
+                fragment_counterparts[i] = std::move(target.generated_counterparts);
+                fragment_dual_constraints[i] = std::move(target.dual_constraints);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(build_threads(), ro_constraints.size()); ++i) {
+        threads.emplace_back(build_fragments);
+    }
+    build_fragments();
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < ro_constraints.size(); ++i) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+        size_t const first_constraint_number = soc_model().soc_constraints().size();
+        auto const spliced_variables = soc_model().splice(*fragments[i]);
+        for (auto& coefficient: fragment_coefficients[i]) {
+            coefficient.dual_variable = spliced_variables[coefficient.dual_variable.raw_id()];
+            coefficient.constraint_number += first_constraint_number;
+            _parametric_coefficients.emplace_back(std::move(coefficient));
+        }
+        for (auto& counterpart: fragment_counterparts[i]) {
+            counterpart.epigraph_var = spliced_variables[counterpart.epigraph_var.raw_id()];
+            _generated_counterparts.emplace_back(std::move(counterpart));
+        }
+        for (auto const& [uvar, constraint_number]: fragment_dual_constraints[i]) {
+            _dual_constraints.emplace_back(uvar, first_constraint_number + constraint_number);
+        }
+        fragments[i].reset();
+    }
 }
 
 void AffineAdjustablePolicySolver::build_objective() {
+    CounterpartTarget target{soc_model()};
     switch (model().objective().sense()) {
         case ObjectiveSense::MAX: {
             auto const obj = add_counterpart_constraints_for_minimization(
+                    target,
                     RoAffineExpression(model().objective().expression()),
                     "Objective");
             soc_model().add_objective({ObjectiveSense::MAX, obj});
-            return;
+            break;
         }
         case ObjectiveSense::MIN: {
             auto const obj = add_counterpart_constraints_for_minimization(
+                    target,
                     -RoAffineExpression(model().objective().expression()),
                     "Objective");
             soc_model().add_objective({ObjectiveSense::MIN, -obj});
-            return;
+            break;
         }
     }
+    std::move(target.parametric_coefficients.begin(), target.parametric_coefficients.end(),
+              std::back_inserter(_parametric_coefficients));
+    std::move(target.generated_counterparts.begin(), target.generated_counterparts.end(),
+              std::back_inserter(_generated_counterparts));
+    std::move(target.dual_constraints.begin(), target.dual_constraints.end(), std::back_inserter(_dual_constraints));
 }
 
 std::vector<SOCVariable::Reference> const& AffineAdjustablePolicySolver::adjustable_factors(DecisionVariable::Index id) const {
     return _adjustable_factors.at(id.raw_id());
 }
 
+std::vector<UncertaintyVariable::Reference> const&
+AffineAdjustablePolicySolver::dependencies(DecisionVariable::Index id) const {
+    return _dependencies.at(id.raw_id());
+}
+
 SOCVariable::Reference const& AffineAdjustablePolicySolver::adjustable_constant(DecisionVariable::Index id) const {
     return _adjustable_constants.at(id.raw_id());
 }
@@ -324,15 +929,30 @@ SolutionRealization AffineAdjustablePolicySolver::specific_solution(std::vector<
     std::vector<double> solutions(model().num_dvars(), 0);
     for (auto const& dvar: model().decision_variables()) {
         solutions.at(dvar.id().raw_id()) = adjustable_constant(dvar.id())->solution();
-        for (size_t i = 0; i < dvar.dependencies().size(); ++i) {
+        for (size_t i = 0; i < dependencies(dvar.id()).size(); ++i) {
             solutions.at(dvar.id().raw_id()) +=
-                    uncertainty_realization.at(dvar.dependencies().at(i).raw_id())
+                    uncertainty_realization.at(dependencies(dvar.id()).at(i).raw_id())
                     * adjustable_factors(dvar.id()).at(i)->solution();
         }
     }
     return SolutionRealization(model(), uncertainty_realization, solutions);
 }
 
+AffinePolicyEvaluator AffineAdjustablePolicySolver::policy_evaluator() const {
+    helpers::exception_check(has_solution(), "Policies can only be evaluated, when a solution exists!");
+    std::vector<double> constants;
+    std::vector<std::vector<std::pair<size_t, double>>> factors;
+    for (auto const& dvar: model().decision_variables()) {
+        constants.emplace_back(adjustable_constant(dvar.id())->solution());
+        factors.emplace_back();
+        for (size_t i = 0; i < dependencies(dvar.id()).size(); ++i) {
+            factors.back().emplace_back(dependencies(dvar.id()).at(i).raw_id(),
+                                        adjustable_factors(dvar.id()).at(i)->solution());
+        }
+    }
+    return {std::move(constants), model().num_uvars(), factors};
+}
+
 void AffineAdjustablePolicySolver::add_average_reoptimization() {
     add_reoptimization_objective_for_realization(
             UncertaintyRealization(
@@ -346,8 +966,8 @@ void AffineAdjustablePolicySolver::add_reoptimization_objective_for_realization(
     std::vector<AffineExpression<SOCVariable::Reference>> decision_substitutions;
     for (auto const& dvar: model().decision_variables()) {
         AffineExpression<SOCVariable::Reference> replacement(adjustable_constant(dvar.id()));
-        for (size_t i = 0; i < dvar.dependencies().size(); ++i) {
-            replacement += adjustable_factors(dvar.id()).at(i) * realization.value(dvar.dependencies().at(i));
+        for (size_t i = 0; i < dependencies(dvar.id()).size(); ++i) {
+            replacement += adjustable_factors(dvar.id()).at(i) * realization.value(dependencies(dvar.id()).at(i));
         }
         decision_substitutions.emplace_back(replacement);
     }
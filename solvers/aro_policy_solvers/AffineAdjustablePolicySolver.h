@@ -5,7 +5,14 @@
 #include "../../models/SOCModel.h"
 #include "../../helpers/helpers.h"
 #include "AROPolicySolverBase.h"
-#include "../soc_solvers/GurobiSOCSolver.h"
+#include "AffinePolicyEvaluator.h"
+#include "../soc_solvers/SOCSolverBase.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace robust_model {
 
@@ -17,55 +24,214 @@ public:
 
     SolutionRealization specific_solution(std::vector<double> const& uncertainty_realization) const final;
 
+    // the solved policies of all decisions for the evaluation of many realizations
+    AffinePolicyEvaluator policy_evaluator() const;
+
+    // starts the next solve from the given policy of a decision, scales of uncertainty variables, which are no
+    // dependencies of the decision, are ignored; has to be called after building
+    void set_start_policy(DecisionVariable::Index dvar, AffineSolution const& policy);
+
     void add_average_reoptimization();
 
     void add_reoptimization_objective_for_realization(UncertaintyRealization const& realization);
 
+    // Solves the objective and the reoptimization objectives one after the other on the same soc model instead of
+    // handing them to the backend as a multi objective model. The optimal value of each objective is kept within
+    // the lexicographic tolerance by a constraint and the backend starts from the previous solution.
+    // The number of reoptimization objectives is not limited. Objectives kept by an earlier solve are not solved
+    // again, when further reoptimization objectives are added. After a parametric update all objectives are solved
+    // again.
+    void set_lexicographic_reoptimization(bool lexicographic);
+
+    bool lexicographic_reoptimization() const;
+
+    // relative to the objective value, absolute for values below one
+    void set_lexicographic_tolerance(double tolerance);
+
+    double lexicographic_tolerance() const;
+
+    // Declares the constants of the uncertainty constraints and the uncertainty variable bounds as parameters.
+    // When they are changed in the ro model, the next solve updates the counterpart in place
+    // and reoptimizes starting from the previous solution instead of building again.
+    // Finite parameters have to stay finite. Has to be set before building.
+    void set_parametric_uncertainty_set(bool parametric);
+
+    bool parametric_uncertainty_set() const;
+
+    // Adds the uncertainty constraint sets of union expressions only when the current policy violates them.
+    // The first solve contains the first set and all sets, which are not boxes. After each solve the most violated
+    // box of every union expression is added, until no box is violated by more than the tolerance.
+    // Has to be set before building.
+    void set_constraint_generation(bool constraint_generation);
+
+    bool constraint_generation() const;
+
+    void set_constraint_generation_tolerance(double tolerance);
+
+    double constraint_generation_tolerance() const;
+
+    // Sensitivity of the solution to each uncertainty variable by raw id: the sum of the absolute dual values of the
+    // rows dualizing the variable in the robust counterparts. Such a dual value is the worst case value of the
+    // variable in its counterpart scaled by the sensitivity of the objective to the counterpart.
+    // Empty, if the backend provided no dual values or no counterpart dualizes the uncertainty variables row by row.
+    std::optional<std::vector<double>> uncertainty_sensitivities() const;
+
+private:
+    // a parameter p of the uncertainty set enters a counterpart constraint as coefficient scale * p of a dual variable
+    struct ParametricCoefficient {
+        std::function<double()> parameter;
+        SOCVariable::Reference dual_variable;
+        double scale;
+        double last_parameter;
+        size_t constraint_number = 0;
+    };
+
+    // counterpart of a union expression, of which only the active uncertainty constraint sets are dualized
+    struct GeneratedCounterpart {
+        RoAffineExpression expr;
+        std::string name_addendum;
+        SOCVariable::Reference epigraph_var;
+        // by position in the constraint sets of the uncertainty set
+        std::vector<bool> active_sets;
+    };
+
+    // bounds of the uncertainty variables within an uncertainty constraint set of variable bounds only
+    using Box = std::pair<std::vector<double>, std::vector<double>>;
+
+    // model the counterparts are added to, either the soc model itself or a fragment built by another thread,
+    // which is spliced into the soc model afterwards
+    struct CounterpartTarget {
+        SOCModel& model;
+        // coefficients of the dual objective, which are not yet part of an epigraph constraint
+        std::vector<ParametricCoefficient> open_parametric_coefficients;
+        std::vector<ParametricCoefficient> parametric_coefficients;
+        std::vector<GeneratedCounterpart> generated_counterparts;
+        // raw id of the uncertainty variable and number of the row dualizing it
+        std::vector<std::pair<size_t, size_t>> dual_constraints;
+    };
+
+    // dual of an uncertainty constraint set together with the uncertainty variable bounds, compiled once and
+    // instantiated for every robust constraint
+    struct UncertaintySetDualTemplate {
+        // dual variable with its dual objective coefficient and, for the constants of the uncertainty constraints
+        // and the bounds, the parameter, which is scale * parameter()
+        struct Multiplier {
+            std::string name;
+            double lb;
+            double ub;
+            double constant;
+            std::function<double()> parameter;
+            double parameter_scale = 0;
+        };
+
+        // norm of the multipliers [first_entry, first_entry + size) <= multiplier
+        struct Cone {
+            size_t multiplier;
+            size_t first_entry;
+            size_t size;
+            VectorNormType norm_type;
+            std::string name;
+        };
+
+        std::vector<Multiplier> multipliers;
+        std::vector<Cone> cones;
+
+        // transposed constraint matrix in compressed sparse row format,
+        // row u holds the multipliers of the dual constraint of uncertainty variable u
+        std::vector<size_t> row_starts = {0};
+        std::vector<size_t> multiplier_indices;
+        std::vector<double> coefficients;
+    };
+
 private:
     void solve_implementation() final;
 
     void build_implementation() final;
 
+    void update_implementation() final;
+
+    void add_parametric_coefficient(CounterpartTarget& target, std::function<double()> const& parameter,
+                                    SOCVariable::Reference dual_variable, double scale);
+
+    // adds epigraph_var <= scale * dual_objective
+    void add_epigraph_constraint(CounterpartTarget& target, SOCVariable::Reference epigraph_var,
+                                 AffineExpression<SOCVariable::Reference> const& dual_objective, double scale,
+                                 std::string const& name);
+
     void build_variables();
 
+    void build_uncertainty_set_dual_templates();
+
+    // special type of the uncertainty set with a closed form counterpart, OTHER if it is dualized
+    UncertaintySet::SpecialSetType closed_form_set_type() const;
+
     void build_constraints();
 
+    // builds the counterparts of the constraints by build_threads() threads into one fragment per constraint
+    void build_constraints_in_parallel(std::vector<ROModel::RoConstraint> const& ro_constraints);
+
     void build_objective();
 
-    void add_ro_constraint(ROModel::RoConstraint const& ro_constr);
+    void add_ro_constraint(CounterpartTarget& target, ROModel::RoConstraint const& ro_constr);
 
     AffineExpression<SOCVariable::Reference>
-    add_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
+    add_counterpart_constraints_for_minimization(CounterpartTarget& target, RoAffineExpression const& expr,
                                                  std::string const& name_addendum);
 
     AffineExpression<SOCVariable::Reference>
-    add_robust_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
+    add_robust_counterpart_constraints_for_minimization(CounterpartTarget& target, RoAffineExpression const& expr,
                                                         std::string const& name_addendum);
 
+    // box, ball and budget sets are not dualized, their counterparts are a single norm of the coefficients
+    // of the uncertainty variables and the bound multipliers
     AffineExpression<SOCVariable::Reference>
-    add_stochastic_counterpart_constraints_for_minimization(RoAffineExpression const& expr,
-                                                            std::string const& name_addendum);
+    add_closed_form_counterpart_constraints_for_minimization(CounterpartTarget& target, RoAffineExpression const& expr,
+                                                             std::string const& name_addendum);
+
+    void
+    add_closed_form_of_box(CounterpartTarget& target, AffineExpression<SOCVariable::Reference>& dual_objective,
+                           std::vector<AffineExpression<SOCVariable::Reference>> const& coefficients,
+                           std::string const& name_addendum);
+
+    void
+    add_closed_form_of_norm_ball(CounterpartTarget& target, AffineExpression<SOCVariable::Reference>& dual_objective,
+                                 std::vector<AffineExpression<SOCVariable::Reference>>& coefficients,
+                                 std::string const& name_addendum);
+
+    // the expectation adds no constraints, it is an expression in the policy variables
+    AffineExpression<SOCVariable::Reference>
+    add_stochastic_counterpart_constraints_for_minimization(RoAffineExpression const& expr);
+
+    // dualizes one uncertainty constraint set and adds the dual constraints, returns the dual objective
+    AffineExpression<SOCVariable::Reference>
+    add_dual_counterpart(CounterpartTarget& target, RoAffineExpression const& expr,
+                         UncertaintySetConstraintsSet::Index union_set_constraints, std::string const& name_addendum);
+
+    void add_generated_uncertainty_set(CounterpartTarget& target, GeneratedCounterpart& counterpart, size_t set_position);
+
+    // adds the most violated box of every generated counterpart and returns the number of added sets
+    size_t add_violated_uncertainty_sets();
+
+    std::optional<size_t> most_violated_uncertainty_set(GeneratedCounterpart const& counterpart,
+                                                        std::vector<std::optional<Box>> const& boxes) const;
 
-    void add_rc_constraints_for_equality(RoAffineExpression const& expr,
+    // by position in the constraint sets, empty for sets with other constraints than variable bounds
+    std::vector<std::optional<Box>> uncertainty_set_boxes() const;
+
+    // coefficients of the uncertainty variables and constant of expr for the solved affine policy
+    std::pair<std::vector<double>, double> policy_coefficients(RoAffineExpression const& expr) const;
+
+    void add_rc_constraints_for_equality(CounterpartTarget& target, RoAffineExpression const& expr,
                                          std::string const& name_addendum);
 
     void
-    add_dual_of_uncertainty_set(AffineExpression<SOCVariable::Reference>& dual_objective,
+    add_dual_of_uncertainty_set(CounterpartTarget& target, AffineExpression<SOCVariable::Reference>& dual_objective,
                                 std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
                                 UncertaintySetConstraintsSet::Index union_set_constraints,
                                 std::string const& name_addendum);
 
-    void
-    add_dual_of_normed_vector(NormedAffineVector<UncertaintyVariable> const& normed_vector,
-                              SOCVariable::Reference dv,
-                              AffineExpression<SOCVariable::Reference>& dual_objective,
-                              std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
-                              std::string const& name_addendum);
-
-    void
-    add_dual_of_uvar_bounds(AffineExpression<SOCVariable::Reference>& dual_objective,
-                            std::vector<AffineExpression<SOCVariable::Reference>>& dual_constraint_expressions,
-                            std::string const& name_addendum);
+    UncertaintySetDualTemplate
+    compile_uncertainty_set_dual_template(UncertaintySetConstraintsSet::Index union_set_constraints) const;
 
     void
     add_dual_of_expression(AffineExpression<SOCVariable::Reference>& dual_objective,
@@ -73,10 +239,22 @@ private:
                            RoAffineExpression const& expr);
 
 
+    // solves the soc model with its current objective, returns the runtime of all rounds of constraint generation
+    double solve_soc_model();
+
+    void solve_lexicographically();
+
+    void add_lexicographic_constraint(SOCModel::Objective const& objective, double value);
+
+    void relax_lexicographic_constraints();
+
     SOCModel& soc_model();
 
     solvers::SOCSolverBase& soc_solver();
 
+    // dependencies of the policy of a decision, the adjustable factors are in the same order
+    std::vector<UncertaintyVariable::Reference> const& dependencies(DecisionVariable::Index id) const;
+
     std::vector<SOCVariable::Reference> const& adjustable_factors(DecisionVariable::Index id) const;
 
     SOCVariable::Reference const& adjustable_constant(DecisionVariable::Index id) const;
@@ -84,10 +262,34 @@ private:
 
 private:
     SOCModel _soc_model;
-    std::unique_ptr<solvers::GurobiSOCSolver> _soc_solver;
+    std::unique_ptr<solvers::SOCSolverBase> _soc_solver;
+    SOCBackend _soc_solver_backend = SOCBackend::ADMM;
+    bool _soc_solver_presolve = false;
+    std::vector<std::vector<UncertaintyVariable::Reference>> _dependencies;
     std::vector<std::vector<SOCVariable::Reference>> _adjustable_factors;
     std::vector<SOCVariable::Reference> _adjustable_constants;
+    UncertaintySet::SpecialSetType _closed_form_set_type = UncertaintySet::SpecialSetType::OTHER;
+    // by raw id of the uncertainty constraint set, read only while the counterparts are built
+    std::vector<UncertaintySetDualTemplate> _uncertainty_set_dual_templates;
+
+    bool _parametric_uncertainty_set = false;
+    std::vector<ParametricCoefficient> _parametric_coefficients;
+
+    bool _constraint_generation = false;
+    double _constraint_generation_tolerance = 1e-6;
+    std::vector<GeneratedCounterpart> _generated_counterparts;
+
+    std::vector<std::pair<size_t, size_t>> _dual_constraints;
 
+    bool _lexicographic_reoptimization = false;
+    double _lexicographic_tolerance = 1e-6;
+    // objectives, whose optimal value is kept by a constraint
+    size_t _lexicographic_objectives = 0;
+    // constraint of objective i: objective <= bound * one (>= for MAX); an update relaxes it by the unbounded
+    // relaxation variable, the next solve tightens it again, since constraints cannot be removed from the soc model
+    std::vector<size_t> _lexicographic_constraints;
+    std::optional<SOCVariable::Reference> _lexicographic_one;
+    std::optional<SOCVariable::Reference> _lexicographic_relaxation;
 };
 
 }
@@ -0,0 +1,100 @@
+#include "AffinePolicyEvaluator.h"
+#include "../../helpers/helpers.h"
+
+#include <algorithm>
+
+namespace robust_model {
+
+AffinePolicyEvaluator::AffinePolicyEvaluator(std::vector<double> constants, size_t const num_uncertainties,
+                                             std::vector<std::vector<std::pair<size_t, double>>> const& factors) :
+        _constants(std::move(constants)), _num_uncertainties(num_uncertainties) {
+    helpers::exception_check(factors.size() == _constants.size(), "Every decision needs its factors!");
+    size_t const num_decisions = _constants.size();
+    _column_starts.assign(num_uncertainties + 1, 0);
+    for (auto const& decision_factors: factors) {
+        for (auto const& [uvar, factor]: decision_factors) {
+            helpers::exception_check(uvar < num_uncertainties, "Factor of an unknown uncertainty variable!");
+            ++_column_starts[uvar + 1];
+        }
+    }
+    for (size_t k = 0; k < num_uncertainties; ++k) {
+        _column_starts[k + 1] += _column_starts[k];
+    }
+    _decision_indices.resize(_column_starts.back());
+    _factors.resize(_column_starts.back());
+    std::vector<size_t> next_positions(_column_starts.begin(), _column_starts.end() - 1);
+    for (size_t d = 0; d < num_decisions; ++d) {
+        for (auto const& [uvar, factor]: factors[d]) {
+            size_t const position = next_positions[uvar]++;
+            _decision_indices[position] = d;
+            _factors[position] = factor;
+        }
+    }
+
+    if (double(_factors.size()) >= DENSITY_THRESHOLD * double(num_decisions * num_uncertainties)) {
+        _dense_factors.assign(num_decisions * num_uncertainties, 0.);
+        for (size_t k = 0; k < num_uncertainties; ++k) {
+            for (size_t p = _column_starts[k]; p < _column_starts[k + 1]; ++p) {
+                _dense_factors[k * num_decisions + _decision_indices[p]] += _factors[p];
+            }
+        }
+    }
+}
+
+size_t AffinePolicyEvaluator::num_decisions() const {
+    return _constants.size();
+}
+
+size_t AffinePolicyEvaluator::num_uncertainties() const {
+    return _num_uncertainties;
+}
+
+bool AffinePolicyEvaluator::dense() const {
+    return not _dense_factors.empty();
+}
+
+void AffinePolicyEvaluator::evaluate(double const* const realizations, size_t const num_samples,
+                                     double* const solutions) const {
+    size_t const num_decisions = _constants.size();
+    bool const dense_factors = dense();
+    for (size_t s = 0; s < num_samples; ++s) {
+        double const* const xi = realizations + s * _num_uncertainties;
+        double* const x = solutions + s * num_decisions;
+        std::copy(_constants.begin(), _constants.end(), x);
+        for (size_t k = 0; k < _num_uncertainties; ++k) {
+            double const value = xi[k];
+            if (value == 0) {
+                continue;
+            }
+            if (dense_factors) {
+                double const* const column = _dense_factors.data() + k * num_decisions;
+                for (size_t d = 0; d < num_decisions; ++d) {
+                    x[d] += value * column[d];
+                }
+            } else {
+                for (size_t p = _column_starts[k]; p < _column_starts[k + 1]; ++p) {
+                    x[_decision_indices[p]] += value * _factors[p];
+                }
+            }
+        }
+    }
+}
+
+void AffinePolicyEvaluator::evaluate(std::vector<double> const& realizations, std::vector<double>& solutions) const {
+    helpers::exception_check(_num_uncertainties == 0 ? realizations.empty()
+                                                     : realizations.size() % _num_uncertainties == 0,
+                             "Every realization needs a value for each uncertainty variable!");
+    size_t const num_samples = _num_uncertainties == 0 ? 0 : realizations.size() / _num_uncertainties;
+    solutions.resize(num_samples * num_decisions());
+    evaluate(realizations.data(), num_samples, solutions.data());
+}
+
+std::vector<double> AffinePolicyEvaluator::evaluate(std::vector<double> const& realization) const {
+    helpers::exception_check(realization.size() == _num_uncertainties,
+                             "The realization needs a value for each uncertainty variable!");
+    std::vector<double> solutions(num_decisions());
+    evaluate(realization.data(), 1, solutions.data());
+    return solutions;
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef ROBUSTOPTIMIZATION_AFFINEPOLICYEVALUATOR_H
+#define ROBUSTOPTIMIZATION_AFFINEPOLICYEVALUATOR_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace robust_model {
+
+// Snapshot of solved affine policies  x = b + F xi, which evaluates batches of uncertainty realizations without
+// access to the models. The factors are stored by uncertainty variable, densely if the policies are dense enough,
+// so that every sample adds scaled contiguous columns to its decisions.
+class AffinePolicyEvaluator {
+public:
+    // factors of each decision as pairs of uncertainty variable raw id and factor
+    AffinePolicyEvaluator(std::vector<double> constants, size_t num_uncertainties,
+                          std::vector<std::vector<std::pair<size_t, double>>> const& factors);
+
+    size_t num_decisions() const;
+
+    size_t num_uncertainties() const;
+
+    bool dense() const;
+
+    // realizations and solutions are row major with one sample per row
+    void evaluate(double const* realizations, size_t num_samples, double* solutions) const;
+
+    // solutions is resized to the number of samples times the number of decisions
+    void evaluate(std::vector<double> const& realizations, std::vector<double>& solutions) const;
+
+    std::vector<double> evaluate(std::vector<double> const& realization) const;
+
+private:
+    std::vector<double> _constants;
+    size_t _num_uncertainties;
+
+    // column k of F, either dense of length num_decisions at k * num_decisions or sparse at the positions
+    // column_starts[k] to column_starts[k+1]-1
+    std::vector<double> _dense_factors;
+    std::vector<size_t> _column_starts;
+    std::vector<size_t> _decision_indices;
+    std::vector<double> _factors;
+
+    // share of nonzero factors from which the factors are stored densely
+    static constexpr double DENSITY_THRESHOLD = 0.25;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_AFFINEPOLICYEVALUATOR_H
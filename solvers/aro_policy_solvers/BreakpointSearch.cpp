@@ -0,0 +1,181 @@
+#include "BreakpointSearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace robust_model {
+
+BreakpointSearch::BreakpointSearch(ROModel const& model) :
+        solvers::AROPolicySolverBase(model) {}
+
+void BreakpointSearch::add_configuration(std::string const& name, Configuration const& configuration) {
+    _configurations.emplace_back(name, configuration);
+}
+
+void BreakpointSearch::add_equidistant_configurations(std::vector<size_t> const& num_pieces,
+                                                      bool const breakpoint_tightening) {
+    for (size_t const pieces: num_pieces) {
+        helpers::exception_check(pieces > 0, "Every configuration needs at least one piece!");
+        add_configuration((breakpoint_tightening ? "LIFT" : "GLIFT") + std::to_string(pieces - 1),
+                          [pieces, breakpoint_tightening](LiftingPolicySolver& solver) {
+                              solver.add_equidistant_breakpoints(pieces);
+                              solver.set_breakpoint_tightening(breakpoint_tightening);
+                          });
+    }
+}
+
+void BreakpointSearch::add_full_kappa_induced_configuration(bool const breakpoint_tightening) {
+    add_configuration(breakpoint_tightening ? "LIFTF" : "GLIFTF", [breakpoint_tightening](LiftingPolicySolver& solver) {
+        solver.add_full_kappa_induced_breakpoints();
+        solver.set_breakpoint_tightening(breakpoint_tightening);
+    });
+}
+
+void BreakpointSearch::set_num_workers(size_t const num_workers) {
+    helpers::exception_check(num_workers > 0, "At least one worker is needed!");
+    _num_workers = num_workers;
+}
+
+std::vector<BreakpointSearch::Candidate> const& BreakpointSearch::candidates() const {
+    return _candidates;
+}
+
+BreakpointSearch::Candidate const& BreakpointSearch::best_candidate() const {
+    helpers::exception_check(_best_candidate.has_value(), "No configuration has been solved!");
+    return _candidates.at(_best_candidate.value());
+}
+
+LiftingPolicySolver const& BreakpointSearch::best_policy() const {
+    helpers::exception_check(bool(_best_policy), "No configuration has been solved!");
+    return *_best_policy;
+}
+
+SolutionRealization BreakpointSearch::specific_solution(std::vector<double> const& uncertainty_realization) const {
+    return best_policy().specific_solution(uncertainty_realization);
+}
+
+void BreakpointSearch::solve_implementation() {
+    helpers::exception_check(not _configurations.empty(), "No break point configuration to search!");
+    _candidates.assign(_configurations.size(), {});
+    for (size_t i = 0; i < _configurations.size(); ++i) {
+        _candidates[i].name = _configurations[i].first;
+    }
+    _best_candidate.reset();
+    _best_policy.reset();
+
+    _start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next_candidate = 0;
+    auto const solve_candidates = [&]() {
+        for (size_t i = next_candidate++; i < _candidates.size(); i = next_candidate++) {
+            // later candidates are left unsolved, once the budget is spent
+            auto const remaining = remaining_runtime();
+            if (cancel_requested() or (remaining and remaining.value() <= 0)) {
+                continue;
+            }
+            solve_candidate(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(_num_workers, _candidates.size()); ++i) {
+        threads.emplace_back(solve_candidates);
+    }
+    solve_candidates();
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    if (_best_policy) {
+        set_results_from_other(*_best_policy);
+        set_runtime(elapsed());
+        helpers::global_logger << "Break point search selected " + best_candidate().name + " with objective value "
+                                  + std::to_string(objective_value());
+    } else if (cancel_requested()) {
+        set_status(Status::INTERRUPTED);
+    } else if (remaining_runtime() and remaining_runtime().value() <= 0) {
+        set_status(Status::TIME_LIMIT);
+    } else {
+        set_status(_candidates.front().status);
+    }
+}
+
+void BreakpointSearch::solve_candidate(size_t const i) {
+    auto solver = std::make_unique<LiftingPolicySolver>(model());
+    _configurations[i].second(*solver);
+    // the parameters are passed one by one, so that every candidate can be cancelled on its own
+    solver->set_runtime_limit(remaining_runtime());
+    solver->set_memory_limit(optional_memory_limit());
+    solver->set_soc_encoding(soc_encoding());
+    solver->set_soc_backend(soc_backend());
+    solver->set_soc_presolve(soc_presolve());
+    solver->set_build_threads(build_threads());
+    solver->set_parameters(parameters());
+    if (dependency_pattern()) {
+        solver->set_dependency_pattern(dependency_pattern());
+    }
+    // the inner solvers keep copies of the callback, which may outlive this call with the best policy,
+    // so it captures nothing of this stack frame
+    auto const pruned = std::make_shared<std::atomic<bool>>(false);
+    solver->set_progress_callback([this, candidate_solver = solver.get(), pruned](Progress const& progress) {
+        if (cancel_requested()) {
+            candidate_solver->cancel();
+        } else if (progress.objective_bound and dominated(progress.objective_bound.value())) {
+            *pruned = true;
+            candidate_solver->cancel();
+        }
+    });
+    solver->solve();
+
+    auto& candidate = _candidates[i];
+    candidate.status = solver->status();
+    candidate.pruned = *pruned;
+    if (solver->has_solution()) {
+        candidate.objective_value = solver->objective_value();
+        candidate.runtime = solver->runtime();
+    }
+    helpers::global_logger << "Break point configuration " + candidate.name + " finished"
+                              + (candidate.pruned ? std::string(" pruned") : std::string())
+                              + (candidate.objective_value ? " with objective value "
+                                                             + std::to_string(candidate.objective_value.value())
+                                                           : std::string(" without solution"));
+
+    std::lock_guard const lock(_best_lock);
+    if (solver->has_solution() and
+        (not _best_policy or better(solver->objective_value(), _best_policy->objective_value()))) {
+        _best_candidate = i;
+        _best_policy = std::move(solver);
+        if (has_progress_callback()) {
+            report_progress({elapsed(), _best_policy->objective_value(), {}, {}, {}});
+        }
+    }
+}
+
+double BreakpointSearch::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+}
+
+std::optional<double> BreakpointSearch::remaining_runtime() const {
+    if (not has_runtime_limit()) {
+        return {};
+    }
+    return runtime_limit() - elapsed();
+}
+
+bool BreakpointSearch::dominated(double const objective_bound) {
+    std::lock_guard const lock(_best_lock);
+    if (not _best_policy) {
+        return false;
+    }
+    double const best = _best_policy->objective_value();
+    double const tolerance = PRUNING_TOLERANCE * std::max(1., std::abs(best));
+    return model().objective().sense() == ObjectiveSense::MIN ? objective_bound > best + tolerance
+                                                              : objective_bound < best - tolerance;
+}
+
+bool BreakpointSearch::better(double const objective_value, double const other_objective_value) const {
+    return model().objective().sense() == ObjectiveSense::MIN ? objective_value < other_objective_value
+                                                              : objective_value > other_objective_value;
+}
+
+}
@@ -0,0 +1,93 @@
+#ifndef ROBUSTOPTIMIZATION_BREAKPOINTSEARCH_H
+#define ROBUSTOPTIMIZATION_BREAKPOINTSEARCH_H
+
+#include "LiftingPolicySolver.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace robust_model {
+
+// Solves LiftingPolicySolvers with different break point configurations on a pool of workers and keeps the best
+// policy found. Configurations are started in the order they were added, while the runtime limit of the search
+// leaves time, each of them gets the remaining time as its runtime limit.
+// A running configuration is cancelled, once the objective bound reported by its backend is worse than the best
+// objective value found so far. Gurobi reports bounds during barrier and MIP solves, ADMM once its iterate is dual
+// feasible within its tolerance.
+// A cancel of the search reaches running configurations with their next progress report.
+class BreakpointSearch : public solvers::AROPolicySolverBase {
+public:
+    // adds the break points and sets the options of a lifting policy solver
+    using Configuration = std::function<void(LiftingPolicySolver&)>;
+
+    struct Candidate {
+        std::string name;
+        Status status = Status::UNSOLVED;
+        std::optional<double> objective_value;
+        double runtime = 0;
+        bool pruned = false;
+    };
+
+public:
+    explicit BreakpointSearch(ROModel const& model);
+
+    void add_configuration(std::string const& name, Configuration const& configuration);
+
+    // LIFT<n-1> with n equidistant pieces per uncertainty variable, GLIFT<n-1> without break point tightening
+    void add_equidistant_configurations(std::vector<size_t> const& num_pieces, bool breakpoint_tightening = true);
+
+    // LIFTF with all kappa induced break points, GLIFTF without break point tightening
+    void add_full_kappa_induced_configuration(bool breakpoint_tightening = true);
+
+    // configurations solved at the same time, each of them uses the threads set in the parameters
+    void set_num_workers(size_t num_workers);
+
+    // results of every configuration of the last search in the order they were added
+    std::vector<Candidate> const& candidates() const;
+
+    Candidate const& best_candidate() const;
+
+    LiftingPolicySolver const& best_policy() const;
+
+    SolutionRealization specific_solution(std::vector<double> const& uncertainty_realization) const final;
+
+private:
+    void solve_implementation() final;
+
+    void solve_candidate(size_t i);
+
+    // seconds since the start of the search
+    double elapsed() const;
+
+    // runtime left for the next candidate, empty without runtime limit
+    std::optional<double> remaining_runtime() const;
+
+    // true if the objective bound of a running candidate cannot reach the best objective value
+    bool dominated(double objective_bound);
+
+    bool better(double objective_value, double other_objective_value) const;
+
+private:
+    std::vector<std::pair<std::string, Configuration>> _configurations;
+    size_t _num_workers = 1;
+
+    std::chrono::steady_clock::time_point _start;
+    std::vector<Candidate> _candidates;
+    std::optional<size_t> _best_candidate;
+    std::unique_ptr<LiftingPolicySolver> _best_policy;
+    // guards the best candidate and its policy while the workers run
+    std::mutex _best_lock;
+
+    // bounds within this distance relative to the best objective value are not pruned
+    static constexpr double PRUNING_TOLERANCE = 1e-6;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_BREAKPOINTSEARCH_H
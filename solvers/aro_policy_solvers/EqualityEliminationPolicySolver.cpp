@@ -0,0 +1,51 @@
+#include "EqualityEliminationPolicySolver.h"
+
+namespace robust_model {
+
+EqualityEliminationPolicySolver::EqualityEliminationPolicySolver(ROModel const& model) :
+        solvers::AROPolicySolverBase(model) {}
+
+void EqualityEliminationPolicySolver::build_implementation() {
+    _eliminator = std::make_unique<ROEqualityEliminator>(model());
+    helpers::global_logger << _eliminator->statistics_string();
+    _affine_model = std::make_unique<AffineAdjustablePolicySolver>(_eliminator->reduced_model());
+    set_parameters_to_other(affine_model());
+    if (dependency_pattern()) {
+        // the reduced model has the uncertainty variables of the original one
+        affine_model().set_dependency_pattern(
+                [this](DecisionVariable const& reduced_dvar, UncertaintyVariable const& uvar) {
+                    return dependency_pattern()(eliminator().original_variable(reduced_dvar),
+                                                model().uncertainty_variables().at(uvar.id().raw_id()));
+                });
+    }
+    affine_model().build();
+}
+
+void EqualityEliminationPolicySolver::solve_implementation() {
+    helpers::exception_check(built(), "Can only solve built model!");
+    set_parameters_to_other(affine_model());
+    affine_model().solve();
+    set_results_from_other(affine_model());
+}
+
+SolutionRealization
+EqualityEliminationPolicySolver::specific_solution(std::vector<double> const& uncertainty_realization) const {
+    return {model(),
+            uncertainty_realization,
+            eliminator().original_solutions(affine_model().specific_solution(uncertainty_realization))};
+}
+
+ROEqualityEliminator const& EqualityEliminationPolicySolver::eliminator() const {
+    helpers::exception_check(bool(_eliminator), "The model is only reduced when building!");
+    return *_eliminator;
+}
+
+AffineAdjustablePolicySolver& EqualityEliminationPolicySolver::affine_model() {
+    return *_affine_model;
+}
+
+AffineAdjustablePolicySolver const& EqualityEliminationPolicySolver::affine_model() const {
+    return *_affine_model;
+}
+
+}
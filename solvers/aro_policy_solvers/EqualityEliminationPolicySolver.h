@@ -0,0 +1,36 @@
+#ifndef ROBUSTOPTIMIZATION_EQUALITYELIMINATIONPOLICYSOLVER_H
+#define ROBUSTOPTIMIZATION_EQUALITYELIMINATIONPOLICYSOLVER_H
+
+#include "AffineAdjustablePolicySolver.h"
+#include "../../models/ROEqualityEliminator.h"
+
+#include <memory>
+
+namespace robust_model {
+
+// Finds affine policies for the model reduced by ROEqualityEliminator. The policies of the eliminated decisions
+// follow from their definitions, so specific solutions are given for all decisions of the original model.
+class EqualityEliminationPolicySolver : public solvers::AROPolicySolverBase {
+public:
+    explicit EqualityEliminationPolicySolver(ROModel const& model);
+
+    SolutionRealization specific_solution(std::vector<double> const& uncertainty_realization) const final;
+
+    ROEqualityEliminator const& eliminator() const;
+
+private:
+    void solve_implementation() final;
+
+    void build_implementation() final;
+
+    AffineAdjustablePolicySolver& affine_model();
+    AffineAdjustablePolicySolver const& affine_model() const;
+
+private:
+    std::unique_ptr<ROEqualityEliminator> _eliminator;
+    std::unique_ptr<AffineAdjustablePolicySolver> _affine_model;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_EQUALITYELIMINATIONPOLICYSOLVER_H
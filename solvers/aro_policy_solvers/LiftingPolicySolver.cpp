@@ -1,5 +1,11 @@
 #include "LiftingPolicySolver.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <tuple>
 #include <utility>
 
 namespace robust_model {
@@ -9,7 +15,9 @@ SingleDirectionBreakPoints::SingleDirectionBreakPoints(helpers::SmartIndex<Singl
                                                        SingleDirectionBreakPoints::BreakPointDirection break_point_direction)
         : IndexedObject<SingleDirectionBreakPoints>(id),
           _break_points(std::move(break_points)),
-          _break_point_direction(std::move(break_point_direction)) {}
+          _break_point_direction(std::move(break_point_direction)) {
+    update_piece_bounds();
+}
 
 bool SingleDirectionBreakPoints::simple_axis_aligned() const {
     if (break_point_direction().scaled_variables().size() != 1) {
@@ -36,15 +44,28 @@ std::vector<double>
 SingleDirectionBreakPoints::lifted_uncertainty_realization(
         UncertaintyRealization const& uncertainty_realization) const {
     double const directed_realization = break_point_direction().value(uncertainty_realization);
-    std::vector<double> lifted_realization(break_points().size() + 1);
-    for (size_t i = 0; i <= break_points().size(); ++i) {
-        double const lb = previous_break_point(i);
-        double const ub = break_point(i);
-        lifted_realization.at(i) = std::max(std::min(directed_realization, ub) - lb, 0.);
-    }
+    std::vector<double> lifted_realization(num_pieces());
+    lift_directed_values(&directed_realization, 1, lifted_realization.data());
     return lifted_realization;
 }
 
+size_t SingleDirectionBreakPoints::num_pieces() const {
+    return break_points().size() + 1;
+}
+
+void SingleDirectionBreakPoints::lift_directed_values(double const* const directed_values, size_t const num_samples,
+                                                      double* const lifted) const {
+    for (size_t i = 0; i < num_pieces(); ++i) {
+        double const lb = _piece_lower_bounds[i];
+        double const ub = _piece_upper_bounds[i];
+        double* const piece = lifted + i * num_samples;
+        // the part of each value above the lower bound of the piece, capped at its upper bound
+        for (size_t s = 0; s < num_samples; ++s) {
+            piece[s] = std::max(std::min(directed_values[s], ub) - lb, 0.);
+        }
+    }
+}
+
 SingleDirectionBreakPoints::BreakPoint SingleDirectionBreakPoints::previous_break_point(size_t i) const {
     return (i > 0) ?
            break_points().at(i - 1) :
@@ -57,38 +78,77 @@ SingleDirectionBreakPoints::BreakPoint SingleDirectionBreakPoints::break_point(s
            break_point_direction().ub();
 }
 
+void SingleDirectionBreakPoints::split_piece(size_t const i) {
+    helpers::exception_check(i < num_pieces(), "Piece to split does not exist!");
+    double const midpoint = 0.5 * (previous_break_point(i) + break_point(i));
+    _break_points.insert(_break_points.begin() + long(i), midpoint);
+    update_piece_bounds();
+}
+
+void SingleDirectionBreakPoints::set_break_points(BreakPointsSeries break_points) {
+    _break_points = std::move(break_points);
+    update_piece_bounds();
+}
+
+void SingleDirectionBreakPoints::update_piece_bounds() {
+    _piece_lower_bounds.resize(num_pieces());
+    _piece_upper_bounds.resize(num_pieces());
+    for (size_t i = 0; i < num_pieces(); ++i) {
+        _piece_lower_bounds[i] = previous_break_point(i);
+        _piece_upper_bounds[i] = break_point(i);
+    }
+}
+
 SOExpectationProviderLifted::SOExpectationProviderLifted(SOExpectationProvider const& base_expectation_provider,
                                                          LiftingPolicySolver const& lifting_policy_solver)
         : _base_expectation_provider(base_expectation_provider), _lifting_policy_solver(lifting_policy_solver) {}
 
+SOExpectationProviderEmpirical const& SOExpectationProviderLifted::lifted_expectation_provider() const {
+    std::call_once(_lifting_flag, [this]() {
+        auto const* base_expectation_provider = &_base_expectation_provider;
+        while (auto const* reference = dynamic_cast<SOExpectationProviderReference const*>(base_expectation_provider)) {
+            base_expectation_provider = &reference->base_expectation_provider();
+        }
+        auto const* empirical = dynamic_cast<SOExpectationProviderEmpirical const*>(base_expectation_provider);
+        helpers::exception_check(empirical != nullptr,
+                                 "Only the realizations of empirical expectation providers can be lifted!");
+        size_t const num_samples = empirical->realizations().size();
+        std::vector<double> realizations;
+        for (auto const& realization: empirical->realizations()) {
+            realizations.insert(realizations.end(), realization.values().begin(), realization.values().end());
+        }
+        auto const lifted = _lifting_policy_solver.lifted_uncertainty_realizations(realizations);
+        size_t const num_lifted_uvars = num_samples == 0 ? 0 : lifted.size() / num_samples;
+        std::vector<UncertaintyRealization> lifted_realizations;
+        lifted_realizations.reserve(num_samples);
+        for (size_t s = 0; s < num_samples; ++s) {
+            lifted_realizations.emplace_back(std::vector<double>(
+                    lifted.begin() + long(s * num_lifted_uvars), lifted.begin() + long((s + 1) * num_lifted_uvars)));
+        }
+        _lifted_expectation_provider = std::make_unique<SOExpectationProviderEmpirical>(
+                std::move(lifted_realizations));
+    });
+    return *_lifted_expectation_provider;
+}
+
 double SOExpectationProviderLifted::expected_value(
         std::function<double(UncertaintyRealization const&)> const& fct) const {
-    return _base_expectation_provider.expected_value(
-            [&](UncertaintyRealization const& realization) {
-                return fct(UncertaintyRealization(
-                        _lifting_policy_solver.lifted_uncertainty_realization(realization.values())));
-            }
-    );
+    return lifted_expectation_provider().expected_value(fct);
 }
 
 std::vector<double> SOExpectationProviderLifted::expected_value(
         std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const {
-    return _base_expectation_provider.expected_value(
-            [&](UncertaintyRealization const& realization) {
-                return fct(UncertaintyRealization(
-                        _lifting_policy_solver.lifted_uncertainty_realization(realization.values())));
-            }
-    );
+    return lifted_expectation_provider().expected_value(fct);
 }
 
 std::vector<std::vector<double>> SOExpectationProviderLifted::expected_value(
         std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const {
-    return _base_expectation_provider.expected_value(
-            [&](UncertaintyRealization const& realization) {
-                return fct(UncertaintyRealization(
-                        _lifting_policy_solver.lifted_uncertainty_realization(realization.values())));
-            }
-    );
+    return lifted_expectation_provider().expected_value(fct);
+}
+
+SOExpectationProvider::SparseEntries SOExpectationProviderLifted::expected_value(
+        std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const {
+    return lifted_expectation_provider().expected_value(fct);
 }
 
 LiftingPolicySolver::LiftingPolicySolver(ROModel const& original_model) :
@@ -149,12 +209,31 @@ void LiftingPolicySolver::add_full_kappa_induced_breakpoints() {
     add_kappa_induced_breakpoints(model().num_uvars());
 }
 
+void LiftingPolicySolver::set_adaptive_refinement(size_t const refinements, size_t const splits_per_refinement) {
+    helpers::exception_check(splits_per_refinement > 0, "At least one piece has to be split per refinement!");
+    _refinements = refinements;
+    _splits_per_refinement = splits_per_refinement;
+}
+
+std::vector<SingleDirectionBreakPoints> const& LiftingPolicySolver::break_point_series() const {
+    return objects();
+}
+
 void LiftingPolicySolver::build_implementation() {
     helpers::exception_check(not built(), "Only build model once!");
+    build_lifted_model();
+}
+
+void LiftingPolicySolver::build_lifted_model() {
+    // the bounds of the directions may have changed with the uncertainty set since the break points were added
+    for (auto& break_point_series: non_const_objects()) {
+        break_point_series.update_piece_bounds();
+    }
+    _lifted_model = std::make_unique<ROModel>();
     if (_all_simple_axis_aligned) {
         build_axis_aligned_model();
     } else {
-        helpers::exception_throw("Not implemented yet!");
+        build_general_model();
     }
 //    if (_breakpoint_tightening) {
 //        add_domination_motivated_tightening_constraint();
@@ -163,19 +242,84 @@ void LiftingPolicySolver::build_implementation() {
         lifted_model().set_expectation_provider(std::make_unique<SOExpectationProviderLifted>(
                 model().expectation_provider(), *this));
     }
-    _affine_model = std::make_unique<AffineAdjustablePolicySolver>(_lifted_model);
+    _affine_model = std::make_unique<AffineAdjustablePolicySolver>(lifted_model());
+    if (dependency_pattern()) {
+        affine_model().set_dependency_pattern(lifted_dependency_pattern());
+    }
     affine_model().build();
 }
 
+LiftingPolicySolver::LiftedModel LiftingPolicySolver::release_lifted_model() {
+    LiftedModel lifted{std::move(_affine_model),
+                       std::move(_lifted_model),
+                       std::move(_lifted_decision_variables),
+                       std::move(_lifted_uncertainty_variables),
+                       std::move(_lifted_uncertainty_retractions),
+                       std::move(_retained_uncertainty_variables),
+                       std::move(_lifted_uncertainty_origins)};
+    _lifted_decision_variables.clear();
+    _lifted_uncertainty_variables.clear();
+    _lifted_uncertainty_retractions.clear();
+    _retained_uncertainty_variables.clear();
+    _lifted_uncertainty_origins.clear();
+    return lifted;
+}
+
+void LiftingPolicySolver::restore_lifted_model(LiftedModel lifted_model) {
+    _affine_model = std::move(lifted_model.affine_model);
+    _lifted_model = std::move(lifted_model.lifted_model);
+    _lifted_decision_variables = std::move(lifted_model.lifted_decision_variables);
+    _lifted_uncertainty_variables = std::move(lifted_model.lifted_uncertainty_variables);
+    _lifted_uncertainty_retractions = std::move(lifted_model.lifted_uncertainty_retractions);
+    _retained_uncertainty_variables = std::move(lifted_model.retained_uncertainty_variables);
+    _lifted_uncertainty_origins = std::move(lifted_model.lifted_uncertainty_origins);
+}
+
+void LiftingPolicySolver::set_start_policies(LiftedModel const& previous,
+                                             std::vector<BreakPointsSeries> const& previous_break_points) {
+    // lifted uncertainty variable of the previous model, which contains each lifted uncertainty variable
+    std::vector<std::optional<UncertaintyVariable::Index>> previous_uvars(lifted_model().num_uvars());
+    for (size_t j = 0; j < _retained_uncertainty_variables.size(); ++j) {
+        previous_uvars.at(_retained_uncertainty_variables[j].raw_id()) = previous.retained_uncertainty_variables.at(j);
+    }
+    for (auto const& break_point_series: objects()) {
+        size_t const direction = break_point_series.id().raw_id();
+        auto const& break_points = previous_break_points.at(direction);
+        for (size_t i = 0; i < break_point_series.num_pieces(); ++i) {
+            size_t const previous_piece = std::upper_bound(break_points.begin(), break_points.end(),
+                                                           break_point_series.previous_break_point(i))
+                                          - break_points.begin();
+            previous_uvars.at(_lifted_uncertainty_variables.at(direction).at(i).raw_id()) =
+                    previous.lifted_uncertainty_variables.at(direction).at(previous_piece);
+        }
+    }
+    for (size_t j = 0; j < _lifted_decision_variables.size(); ++j) {
+        auto const previous_policy = previous.affine_model->affine_solution(previous.lifted_decision_variables.at(j));
+        std::map<UncertaintyVariable::Index, double> dependent_scales;
+        for (auto const& lifted_uvar: lifted_model().uncertainty_variables()) {
+            auto const& previous_uvar = previous_uvars.at(lifted_uvar.id().raw_id());
+            if (not previous_uvar.has_value()) {
+                continue;
+            }
+            auto const scale = previous_policy.dependent_scales().find(previous_uvar.value());
+            if (scale != previous_policy.dependent_scales().end()) {
+                dependent_scales[lifted_uvar.id()] = scale->second;
+            }
+        }
+        affine_model().set_start_policy(_lifted_decision_variables[j],
+                                        AffineSolution(previous_policy.constant(), dependent_scales));
+    }
+}
+
 void LiftingPolicySolver::build_axis_aligned_model() {
     helpers::exception_check(_all_simple_axis_aligned, "Not all break points are simple axis aligned!");
 
     axis_aligned_lifted_model_add_lifted_uncertainty_variables();
-    axis_aligned_lifted_model_add_retracted_uncertainty_constraints();
+    lifted_model_add_retracted_uncertainty_constraints();
 
     add_decision_variables();
-    axis_aligned_lifted_model_add_retracted_constraints();
-    axis_aligned_lifted_model_add_retracted_objective();
+    lifted_model_add_retracted_constraints();
+    lifted_model_add_retracted_objective();
 
     add_box_tightening_constraints();
     if (all_rotational_invariant_axis_aligned_breakpoints() and
@@ -186,12 +330,37 @@ void LiftingPolicySolver::build_axis_aligned_model() {
 }
 
 
+void LiftingPolicySolver::build_general_model() {
+    general_lifted_model_add_lifted_uncertainty_variables();
+    lifted_model_add_retracted_uncertainty_constraints();
+    general_lifted_model_add_direction_constraints();
+
+    add_decision_variables();
+    lifted_model_add_retracted_constraints();
+    lifted_model_add_retracted_objective();
+}
+
 void LiftingPolicySolver::add_decision_variables() {
     for (auto const& dvar: model().decision_variables()) {
+        if (dvar.has_period()) {
+            _lifted_decision_variables.emplace_back(
+                    lifted_model().add_decision_variable(dvar.name(), dvar.period(), dvar.lb(), dvar.ub()));
+            continue;
+        }
+        // a lifted uncertainty variable is known, when all of its original uncertainty variables are known
+        std::vector<bool> known(model().num_uvars(), false);
+        for (auto const& uvar: dvar.dependencies()) {
+            known.at(uvar.raw_id()) = true;
+        }
+        std::vector<UncertaintyVariable::Reference> dependencies;
+        for (auto const& lifted_uvar: lifted_model().uncertainty_variables()) {
+            auto const& origins = _lifted_uncertainty_origins.at(lifted_uvar.id().raw_id());
+            if (std::all_of(origins.begin(), origins.end(), [&](size_t uvar) { return known.at(uvar); })) {
+                dependencies.push_back(lifted_uvar.reference());
+            }
+        }
         _lifted_decision_variables.emplace_back(
-                lifted_model().add_decision_variable(dvar.name(),
-                                                     (dvar.has_period()) ? dvar.period() : std::optional<period_id>{},
-                                                     dvar.lb(), dvar.ub()));
+                lifted_model().add_decision_variable(dvar.name(), dependencies, dvar.lb(), dvar.ub()));
     }
 }
 
@@ -210,6 +379,7 @@ void LiftingPolicySolver::axis_aligned_lifted_model_add_lifted_uncertainty_varia
                             break_point - prev_break_point
                     )
             );
+            _lifted_uncertainty_origins.push_back({udirection.raw_id()});
             if (i > 0) {
                 lifted_model().add_uncertainty_constraint(
                         _lifted_uncertainty_variables.back().at(i) /
@@ -228,7 +398,64 @@ void LiftingPolicySolver::axis_aligned_lifted_model_add_lifted_uncertainty_varia
     }
 }
 
-void LiftingPolicySolver::axis_aligned_lifted_model_add_retracted_uncertainty_constraints() {
+void LiftingPolicySolver::general_lifted_model_add_lifted_uncertainty_variables() {
+    for (auto const& uvar: model().uncertainty_variables()) {
+        _retained_uncertainty_variables.emplace_back(lifted_model().add_uncertainty_variable(
+                uvar.name(), uvar.has_period() ? uvar.period() : std::optional<period_id>{}, uvar.lb(), uvar.ub()));
+        _lifted_uncertainty_retractions.emplace_back(_retained_uncertainty_variables.back());
+        _lifted_uncertainty_origins.push_back({uvar.id().raw_id()});
+    }
+    for (auto const& break_point_series: objects()) {
+        auto const& direction = break_point_series.break_point_direction();
+        helpers::exception_check(std::isfinite(direction.lb()) and std::isfinite(direction.ub()),
+                                 "Break point directions have to be bounded by the uncertainty variable bounds!");
+        // the pieces are known in the last period of the direction, without period if one of its variables has none
+        std::vector<size_t> origins;
+        std::optional<period_id> period = period_id(0);
+        for (auto const& svar: direction.scaled_variables()) {
+            origins.push_back(svar.variable().raw_id());
+            auto const& uvar = model().uncertainty_variables().at(svar.variable().raw_id());
+            period = (period and uvar.has_period()) ? std::max(period.value(), uvar.period())
+                                                    : std::optional<period_id>{};
+        }
+        _lifted_uncertainty_variables.emplace_back();
+        for (size_t i = 0; i < break_point_series.num_pieces(); ++i) {
+            _lifted_uncertainty_variables.back().emplace_back(lifted_model().add_uncertainty_variable(
+                    "Dir" + std::to_string(break_point_series.id().raw_id()) + "_L" + std::to_string(i), period, 0,
+                    break_point_series.break_point(i) - break_point_series.previous_break_point(i)));
+            _lifted_uncertainty_origins.push_back(origins);
+        }
+    }
+}
+
+void LiftingPolicySolver::general_lifted_model_add_direction_constraints() {
+    for (auto const lifted_union_uncertainty_set: lifted_model().uncertainty_set().constraint_sets()) {
+        std::string const set_name = "_US" + std::to_string(lifted_union_uncertainty_set.raw_id());
+        for (auto const& break_point_series: objects()) {
+            auto const& lifted_uvars = _lifted_uncertainty_variables.at(break_point_series.id().raw_id());
+            std::string const direction_name = "Dir" + std::to_string(break_point_series.id().raw_id());
+            // the pieces add up to the value of the direction above its lower bound
+            lifted_model().add_uncertainty_constraint(
+                    LinearExpression<UncertaintyVariable::Reference>::sum(lifted_uvars)
+                    - break_point_series.break_point_direction().substitute<UncertaintyVariable::Reference>(
+                            _lifted_uncertainty_retractions)
+                    + break_point_series.previous_break_point(0)
+                    == 0,
+                    "LiftedDirection" + direction_name + set_name,
+                    lifted_union_uncertainty_set);
+            for (size_t i = 1; i < lifted_uvars.size(); ++i) {
+                lifted_model().add_uncertainty_constraint(
+                        lifted_uvars.at(i) / lifted_uvars.at(i).ub()
+                        <=
+                        lifted_uvars.at(i - 1) / lifted_uvars.at(i - 1).ub(),
+                        "BoundLiftedWithPrevious" + direction_name + "_" + std::to_string(i) + set_name,
+                        lifted_union_uncertainty_set);
+            }
+        }
+    }
+}
+
+void LiftingPolicySolver::lifted_model_add_retracted_uncertainty_constraints() {
     for (auto const union_uncertainty_set: model().uncertainty_set().constraint_sets()) {
         if (union_uncertainty_set.raw_id() > 0) {
             lifted_model().add_uncertainty_constraint_set();
@@ -244,7 +471,7 @@ void LiftingPolicySolver::axis_aligned_lifted_model_add_retracted_uncertainty_co
     }
 }
 
-void LiftingPolicySolver::axis_aligned_lifted_model_add_retracted_constraints() {
+void LiftingPolicySolver::lifted_model_add_retracted_constraints() {
     for (auto const& roconstr: model().constraints()) {
         lifted_model().add_constraint(
                 {
@@ -256,7 +483,7 @@ void LiftingPolicySolver::axis_aligned_lifted_model_add_retracted_constraints()
     }
 }
 
-void LiftingPolicySolver::axis_aligned_lifted_model_add_retracted_objective() {
+void LiftingPolicySolver::lifted_model_add_retracted_objective() {
     auto const& old_obj = model().objective();
     lifted_model().set_objective(
             old_obj.expression().substitute(_lifted_decision_variables, _lifted_uncertainty_retractions),
@@ -476,7 +703,107 @@ void LiftingPolicySolver::solve_implementation() {
     helpers::exception_check(built(), "Can only solve built model!");
     set_parameters_to_other(affine_model());
     affine_model().solve();
+    double runtime = affine_model().has_solution() ? affine_model().runtime() : 0.;
+    // Splitting a piece adds a lifted uncertainty variable, which every robust counterpart dualizes, so the lifted
+    // model is rebuilt for each refinement and starts from the previous policy. The runtime includes the rebuilds.
+    for (size_t refinement = 1; refinement <= _refinements; ++refinement) {
+        if (affine_model().status() != Status::OPTIMAL or cancel_requested()) {
+            break;
+        }
+        double const previous_objective_value = affine_model().objective_value();
+        std::vector<BreakPointsSeries> previous_break_points;
+        for (auto const& break_point_series: objects()) {
+            previous_break_points.push_back(break_point_series.break_points());
+        }
+        size_t const split_pieces = refine_break_points();
+        if (split_pieces == 0) {
+            break;
+        }
+        // the last optimal lifted model is kept, until the refined one is solved to optimality
+        auto previous_lifted_model = release_lifted_model();
+        auto const build_start = std::chrono::steady_clock::now();
+        build_lifted_model();
+        set_start_policies(previous_lifted_model, previous_break_points);
+        double const build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+        set_parameters_to_other(affine_model());
+        affine_model().solve();
+        double const solve_time = affine_model().has_solution() ? affine_model().runtime() : 0.;
+        runtime += build_time + solve_time;
+        helpers::global_logger << "Break point refinement " + std::to_string(refinement) + " split "
+                                  + std::to_string(split_pieces) + " pieces, build time "
+                                  + std::to_string(build_time) + "s, solve time " + std::to_string(solve_time)
+                                  + "s, objective value " + std::to_string(previous_objective_value) + " -> "
+                                  + (affine_model().has_solution() ? std::to_string(affine_model().objective_value())
+                                                                   : std::string("none"));
+        if (affine_model().status() != Status::OPTIMAL) {
+            for (size_t i = 0; i < previous_break_points.size(); ++i) {
+                non_const_objects().at(i).set_break_points(std::move(previous_break_points[i]));
+            }
+            restore_lifted_model(std::move(previous_lifted_model));
+            helpers::global_logger << "Break point refinement " + std::to_string(refinement)
+                                      + " is not optimal, the previous break points are kept";
+            break;
+        }
+    }
     set_results_from_other(affine_model());
+    if (has_solution()) {
+        set_runtime(runtime);
+    }
+}
+
+size_t LiftingPolicySolver::refine_break_points() {
+    // (score, direction, piece) of every piece, that can be split
+    std::vector<std::tuple<double, size_t, size_t>> candidates;
+    auto const sensitivities = affine_model().uncertainty_sensitivities();
+    for (auto const& break_point_series: objects()) {
+        double const width = break_point_series.break_point(break_point_series.num_pieces() - 1)
+                             - break_point_series.previous_break_point(0);
+        for (size_t i = 0; i < break_point_series.num_pieces(); ++i) {
+            double const piece_width = break_point_series.break_point(i) - break_point_series.previous_break_point(i);
+            if (not std::isfinite(piece_width) or piece_width <= MIN_PIECE_WIDTH * std::max(1., width)) {
+                continue;
+            }
+            double const score = sensitivities ?
+                    sensitivities->at(_lifted_uncertainty_variables.at(break_point_series.id().raw_id()).at(i).raw_id())
+                    : piece_width / width;
+            candidates.emplace_back(score, break_point_series.id().raw_id(), i);
+        }
+    }
+    // a solution without any sensitive piece is refined by width as well
+    bool const sensitive = std::any_of(candidates.begin(), candidates.end(),
+                                       [](auto const& candidate) { return std::get<0>(candidate) > 0; });
+    if (sensitivities and not sensitive) {
+        for (auto& [score, direction, piece]: candidates) {
+            auto const& break_point_series = objects().at(direction);
+            score = (break_point_series.break_point(piece) - break_point_series.previous_break_point(piece))
+                    / (break_point_series.break_point(break_point_series.num_pieces() - 1)
+                       - break_point_series.previous_break_point(0));
+        }
+    }
+    size_t const num_splits = std::min(_splits_per_refinement, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + long(num_splits), candidates.end(),
+                      [](auto const& first, auto const& second) { return std::get<0>(first) > std::get<0>(second); });
+    candidates.resize(num_splits);
+    // splitting moves the later pieces of the direction, so they are split first
+    std::sort(candidates.begin(), candidates.end(), [](auto const& first, auto const& second) {
+        return std::tie(std::get<1>(first), std::get<2>(first)) > std::tie(std::get<1>(second), std::get<2>(second));
+    });
+    for (auto const& [score, direction, piece]: candidates) {
+        non_const_objects().at(direction).split_piece(piece);
+    }
+    return num_splits;
+}
+
+LiftingPolicySolver::DependencyPattern LiftingPolicySolver::lifted_dependency_pattern() const {
+    // the lifted decisions are in the order of the original ones, a lifted uncertainty variable is accepted, when
+    // all of its original uncertainty variables are
+    return [this](DecisionVariable const& lifted_dvar, UncertaintyVariable const& lifted_uvar) {
+        auto const& dvar = model().decision_variables().at(lifted_dvar.id().raw_id());
+        auto const& origins = _lifted_uncertainty_origins.at(lifted_uvar.id().raw_id());
+        return std::all_of(origins.begin(), origins.end(), [&](size_t uvar) {
+            return dependency_pattern()(dvar, model().uncertainty_variables().at(uvar));
+        });
+    };
 }
 
 SolutionRealization LiftingPolicySolver::specific_solution(std::vector<double> const& uncertainty_realization) const {
@@ -487,18 +814,52 @@ SolutionRealization LiftingPolicySolver::specific_solution(std::vector<double> c
 
 std::vector<double>
 LiftingPolicySolver::lifted_uncertainty_realization(std::vector<double> const& uncertainty_realization) const {
-    UncertaintyRealization const realization(uncertainty_realization);
-    std::vector<double> lifted_uncertainty(lifted_model().num_uvars());
+    return lifted_uncertainty_realizations(uncertainty_realization);
+}
+
+std::vector<double>
+LiftingPolicySolver::lifted_uncertainty_realizations(std::vector<double> const& uncertainty_realizations) const {
+    size_t const num_uvars = model().num_uvars();
+    size_t const num_lifted_uvars = lifted_model().num_uvars();
+    helpers::exception_check(num_uvars == 0 ? uncertainty_realizations.empty()
+                                            : uncertainty_realizations.size() % num_uvars == 0,
+                             "Every realization needs a value for each uncertainty variable!");
+    size_t const num_samples = num_uvars == 0 ? 0 : uncertainty_realizations.size() / num_uvars;
+    std::vector<double> lifted_uncertainty(num_samples * num_lifted_uvars);
+    std::vector<double> directed_values(num_samples);
+    std::vector<double> lifted_pieces;
+    for (size_t j = 0; j < _retained_uncertainty_variables.size(); ++j) {
+        size_t const retained_uvar = _retained_uncertainty_variables[j].raw_id();
+        for (size_t s = 0; s < num_samples; ++s) {
+            lifted_uncertainty[s * num_lifted_uvars + retained_uvar] = uncertainty_realizations[s * num_uvars + j];
+        }
+    }
     for (auto const& break_point_series: objects()) {
-        auto const break_direction_lifting = break_point_series.lifted_uncertainty_realization(realization);
-        for (size_t i = 0; i <= break_point_series.break_points().size(); ++i) {
-            auto const uvar = _lifted_uncertainty_variables.at(break_point_series.id().raw_id()).at(i);
-            lifted_uncertainty.at(uvar.raw_id()) = break_direction_lifting.at(i);
+        std::fill(directed_values.begin(), directed_values.end(), 0.);
+        for (auto const& svar: break_point_series.break_point_direction().scaled_variables()) {
+            size_t const uvar = svar.variable().raw_id();
+            for (size_t s = 0; s < num_samples; ++s) {
+                directed_values[s] += svar.scale() * uncertainty_realizations[s * num_uvars + uvar];
+            }
+        }
+        lifted_pieces.resize(break_point_series.num_pieces() * num_samples);
+        break_point_series.lift_directed_values(directed_values.data(), num_samples, lifted_pieces.data());
+        auto const& lifted_uvars = _lifted_uncertainty_variables.at(break_point_series.id().raw_id());
+        for (size_t i = 0; i < break_point_series.num_pieces(); ++i) {
+            size_t const lifted_uvar = lifted_uvars.at(i).raw_id();
+            for (size_t s = 0; s < num_samples; ++s) {
+                lifted_uncertainty[s * num_lifted_uvars + lifted_uvar] = lifted_pieces[i * num_samples + s];
+            }
         }
     }
     return lifted_uncertainty;
 }
 
+void LiftingPolicySolver::evaluate_policies(std::vector<double> const& uncertainty_realizations,
+                                            std::vector<double>& solutions) const {
+    affine_model().policy_evaluator().evaluate(lifted_uncertainty_realizations(uncertainty_realizations), solutions);
+}
+
 bool LiftingPolicySolver::all_rotational_invariant_axis_aligned_breakpoints() {
     if (not _all_simple_axis_aligned) {
         return false;
@@ -538,11 +899,11 @@ bool LiftingPolicySolver::all_symmetric_axis_aligned_breakpoints() {
 }
 
 ROModel& LiftingPolicySolver::lifted_model() {
-    return _lifted_model;
+    return *_lifted_model;
 }
 
 ROModel const& LiftingPolicySolver::lifted_model() const {
-    return _lifted_model;
+    return *_lifted_model;
 }
 
 AffineAdjustablePolicySolver& LiftingPolicySolver::affine_model() {
@@ -3,6 +3,9 @@
 
 #include "AffineAdjustablePolicySolver.h"
 
+#include <memory>
+#include <mutex>
+
 namespace robust_model {
 
 class LiftingPolicySolver;
@@ -30,9 +33,25 @@ public:
 
     std::vector<double> lifted_uncertainty_realization(UncertaintyRealization const& uncertainty_realization) const;
 
+    size_t num_pieces() const;
+
+    // Lifts a batch of values of the break point direction. Piece i of sample s is written to
+    // lifted[i * num_samples + s], so that every piece is a contiguous column.
+    void lift_directed_values(double const* directed_values, size_t num_samples, double* lifted) const;
+
+    // adds the midpoint of piece i as break point, the pieces after i move one index up
+    void split_piece(size_t i);
+
+    void set_break_points(BreakPointsSeries break_points);
+
+    // looks up the bounds of every piece for lift_directed_values again, after the bounds of the direction changed
+    void update_piece_bounds();
+
 private:
-    BreakPointsSeries const _break_points;
+    BreakPointsSeries _break_points;
     BreakPointDirection const _break_point_direction;
+    std::vector<double> _piece_lower_bounds;
+    std::vector<double> _piece_upper_bounds;
 };
 
 class SOExpectationProviderLifted : public SOExpectationProvider{
@@ -43,10 +62,18 @@ public:
     double expected_value(std::function<double(UncertaintyRealization const&)> const& fct) const final;
     std::vector<double> expected_value(std::function<std::vector<double>(UncertaintyRealization const&)> const& fct) const final;
     std::vector<std::vector<double>> expected_value(std::function<std::vector<std::vector<double>>(UncertaintyRealization const&)> const& fct) const override;
+    SparseEntries expected_value(std::function<void(UncertaintyRealization const&, SparseEntries&)> const& fct) const final;
+
+private:
+    // the realizations of the base provider lifted once on first use, the base provider has to be empirical or
+    // a reference to an empirical one
+    SOExpectationProviderEmpirical const& lifted_expectation_provider() const;
 
 private:
     SOExpectationProvider const& _base_expectation_provider;
     LiftingPolicySolver const& _lifting_policy_solver;
+    mutable std::once_flag _lifting_flag;
+    mutable std::unique_ptr<SOExpectationProviderEmpirical> _lifted_expectation_provider;
 };
 
 
@@ -75,27 +102,79 @@ public:
 
     void add_full_kappa_induced_breakpoints();
 
+    // After each solve the most sensitive pieces are split at their midpoints and the lifted model is solved again,
+    // starting from the previous policy, until refinements rounds are done. A piece is as sensitive as the sum of
+    // the absolute dual values of the rows dualizing its lifted uncertainty variable. Without dual values from the
+    // backend the widest pieces relative to their direction are split. The rotational invariant tightening needs
+    // equal break points in every direction and is only added while the splits keep them equal. A refinement,
+    // which is not solved to optimality, is dropped and the policy of the previous break points is kept.
+    // Has to be set before solving.
+    void set_adaptive_refinement(size_t refinements, size_t splits_per_refinement = 1);
+
+    // the break points of every direction, including the splits of the adaptive refinement
+    std::vector<SingleDirectionBreakPoints> const& break_point_series() const;
+
     SolutionRealization specific_solution(std::vector<double> const& uncertainty_realization) const final;
 
     std::vector<double> lifted_uncertainty_realization(std::vector<double> const& uncertainty_realization) const;
 
+    // lifts a row major batch of realizations of the original uncertainty variables
+    std::vector<double> lifted_uncertainty_realizations(std::vector<double> const& uncertainty_realizations) const;
+
+    // solutions of all decisions for a row major batch of realizations, one sample per row of solutions
+    void evaluate_policies(std::vector<double> const& uncertainty_realizations, std::vector<double>& solutions) const;
+
+private:
+    // everything build_lifted_model creates, so that a lifted model can be put aside and restored
+    struct LiftedModel {
+        std::unique_ptr<AffineAdjustablePolicySolver> affine_model;
+        std::unique_ptr<ROModel> lifted_model;
+        std::vector<DecisionVariable::Reference> lifted_decision_variables;
+        std::vector<std::vector<UncertaintyVariable::Reference>> lifted_uncertainty_variables;
+        std::vector<AffineExpression<UncertaintyVariable::Reference>> lifted_uncertainty_retractions;
+        std::vector<UncertaintyVariable::Reference> retained_uncertainty_variables;
+        std::vector<std::vector<size_t>> lifted_uncertainty_origins;
+    };
+
 private:
 
     void solve_implementation() final;
 
     void build_implementation() final;
 
+    void build_lifted_model();
+
+    // leaves this solver without lifted model
+    LiftedModel release_lifted_model();
+
+    void restore_lifted_model(LiftedModel lifted_model);
+
+    // Starts the refined lifted model from the policies of the previous one. Refinement only splits pieces, so the
+    // previous policy with the factor of a split piece on each of its parts is a policy of the refined model.
+    void set_start_policies(LiftedModel const& previous, std::vector<BreakPointsSeries> const& previous_break_points);
+
+    // splits the most sensitive pieces of the solved lifted model, returns the number of split pieces
+    size_t refine_break_points();
+
     void build_axis_aligned_model();
 
+    // Keeps the original uncertainty variables and adds the pieces of every break point direction, which are
+    // linked to the value of the direction by an equality in each uncertainty constraint set.
+    void build_general_model();
+
     void add_decision_variables();
 
     void axis_aligned_lifted_model_add_lifted_uncertainty_variables();
 
-    void axis_aligned_lifted_model_add_retracted_uncertainty_constraints();
+    void general_lifted_model_add_lifted_uncertainty_variables();
+
+    void general_lifted_model_add_direction_constraints();
 
-    void axis_aligned_lifted_model_add_retracted_constraints();
+    void lifted_model_add_retracted_uncertainty_constraints();
 
-    void axis_aligned_lifted_model_add_retracted_objective();
+    void lifted_model_add_retracted_constraints();
+
+    void lifted_model_add_retracted_objective();
 
     void add_box_tightening_constraints();
 
@@ -119,6 +198,9 @@ private:
 
     bool all_rotational_invariant_axis_aligned_breakpoints();
 
+    // the dependency pattern of this solver for the lifted model
+    DependencyPattern lifted_dependency_pattern() const;
+
     bool all_symmetric_axis_aligned_breakpoints();
 
     ROModel & lifted_model();
@@ -130,13 +212,22 @@ private:
     bool _all_simple_axis_aligned = true;
     bool _breakpoint_tightening = true;
     bool _use_old_box_constraints = false;
+    size_t _refinements = 0;
+    size_t _splits_per_refinement = 1;
 
     std::unique_ptr<AffineAdjustablePolicySolver> _affine_model;
 
-    ROModel _lifted_model;
+    std::unique_ptr<ROModel> _lifted_model;
     std::vector<DecisionVariable::Reference> _lifted_decision_variables;
     std::vector<std::vector<UncertaintyVariable::Reference>> _lifted_uncertainty_variables;
     std::vector<AffineExpression<UncertaintyVariable::Reference>> _lifted_uncertainty_retractions;
+    // copies of the original uncertainty variables, only kept for general directions
+    std::vector<UncertaintyVariable::Reference> _retained_uncertainty_variables;
+    // raw ids of the original uncertainty variables, which determine each lifted uncertainty variable
+    std::vector<std::vector<size_t>> _lifted_uncertainty_origins;
+
+    // pieces up to this width relative to their direction are not split
+    static constexpr double MIN_PIECE_WIDTH = 1e-6;
 };
 
 }
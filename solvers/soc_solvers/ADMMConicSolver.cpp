@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "ADMMConicSolver.h"
+
+namespace solvers {
+
+ADMMConicSolver::ADMMConicSolver(robust_model::SOCModel& soc_model) :
+        SOCSolverBase(soc_model) {}
+
+double ADMMConicSolver::value(robust_model::SOCVariable::Index const& id) const {
+    helpers::exception_check(has_solution(), "Only extract solution, when it exists!");
+    return _solution_values.at(id.raw_id());
+}
+
+void ADMMConicSolver::set_tolerance(double tolerance) {
+    _tolerance = tolerance;
+}
+
+void ADMMConicSolver::set_max_iterations(size_t max_iterations) {
+    _max_iterations = max_iterations;
+}
+
+size_t ADMMConicSolver::iterations() const {
+    return _iterations;
+}
+
+void ADMMConicSolver::update_implementation() {
+    auto const transfer_start = std::chrono::steady_clock::now();
+    helpers::exception_check(soc_model().is_continuous(), "ADMM can only solve continuous models!");
+    _conic_form = std::make_unique<robust_model::SOCConicForm>(soc_model());
+    // the model is exported again as a whole, so it contains all changed coefficients
+    non_const_soc_model().clear_coefficient_changes();
+    size_t const num_rows = _conic_form->num_rows();
+    size_t const num_columns = _conic_form->num_columns();
+    _row_starts = _conic_form->row_starts();
+    _column_indices = _conic_form->column_indices();
+    _values = _conic_form->values();
+    equilibrate();
+    transpose();
+
+    _b.resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _b[i] = _row_scaling[i] * _conic_form->rhs()[i];
+    }
+    _rhos.resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _rhos[i] = i < _conic_form->num_zero_rows() ? 1e3 * _rho : _rho;
+    }
+    update_preconditioner();
+
+    // warm start from the last solve, when the dimensions did not change, added rows keep the primal start
+    _x.assign(num_columns, 0.);
+    _s.assign(num_rows, 0.);
+    _y.assign(num_rows, 0.);
+    if (_solution_values.size() == num_columns) {
+        for (size_t j = 0; j < num_columns; ++j) {
+            _x[j] = _solution_values[j] / _column_scaling[j];
+        }
+    }
+    if (_solution_values.size() == num_columns and _slacks.size() == num_rows) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            _s[i] = _row_scaling[i] * _slacks[i];
+            _y[i] = _cost_scaling * _dual_values[i] / _row_scaling[i];
+        }
+    }
+    // start values of the model variables replace a missing previous solution, the model variables come first
+    if (_solution_values.size() != num_columns) {
+        for (auto const& start: soc_model().start_values()) {
+            size_t const j = start.variable.raw_id();
+            _x[j] = start.value / _column_scaling[j];
+        }
+    }
+    non_const_soc_model().clear_start_values();
+    set_model_transfer_time(model_transfer_time() + std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - transfer_start).count());
+    set_model_size({num_columns, _conic_form->num_zero_rows() + _conic_form->num_nonnegative_rows(),
+                    _conic_form->second_order_cone_sizes().size()});
+}
+
+void ADMMConicSolver::equilibrate() {
+    static const size_t num_equilibration_iterations = 10;
+    size_t const num_rows = _conic_form->num_rows();
+    size_t const num_columns = _conic_form->num_columns();
+    _row_scaling.assign(num_rows, 1.);
+    _column_scaling.assign(num_columns, 1.);
+    std::vector<double> row_scales(num_rows), column_scales(num_columns);
+    auto const inverse_sqrt = [](double norm) {
+        return norm > 1e-8 ? 1. / std::sqrt(norm) : 1.;
+    };
+    for (size_t iteration = 0; iteration < num_equilibration_iterations; ++iteration) {
+        std::fill(row_scales.begin(), row_scales.end(), 0.);
+        std::fill(column_scales.begin(), column_scales.end(), 0.);
+        for (size_t r = 0; r < num_rows; ++r) {
+            for (int k = _row_starts[r]; k < _row_starts[r + 1]; ++k) {
+                double const abs_value = std::abs(_values[k]);
+                row_scales[r] = std::max(row_scales[r], abs_value);
+                column_scales[_column_indices[k]] = std::max(column_scales[_column_indices[k]], abs_value);
+            }
+        }
+        // the rows of a second order cone are scaled uniformly, otherwise the cone would change
+        size_t cone_start = _conic_form->num_zero_rows() + _conic_form->num_nonnegative_rows();
+        for (auto const cone_size: _conic_form->second_order_cone_sizes()) {
+            auto const cone_begin = row_scales.begin() + long(cone_start);
+            std::fill(cone_begin, cone_begin + long(cone_size), *std::max_element(cone_begin, cone_begin + long(cone_size)));
+            cone_start += cone_size;
+        }
+        std::transform(row_scales.begin(), row_scales.end(), row_scales.begin(), inverse_sqrt);
+        std::transform(column_scales.begin(), column_scales.end(), column_scales.begin(), inverse_sqrt);
+        for (size_t r = 0; r < num_rows; ++r) {
+            for (int k = _row_starts[r]; k < _row_starts[r + 1]; ++k) {
+                _values[k] *= row_scales[r] * column_scales[_column_indices[k]];
+            }
+            _row_scaling[r] *= row_scales[r];
+        }
+        for (size_t j = 0; j < num_columns; ++j) {
+            _column_scaling[j] *= column_scales[j];
+        }
+    }
+
+    _c.resize(num_columns);
+    double cost_norm = 0;
+    for (size_t j = 0; j < num_columns; ++j) {
+        _c[j] = _column_scaling[j] * _conic_form->objective()[j];
+        cost_norm = std::max(cost_norm, std::abs(_c[j]));
+    }
+    _cost_scaling = cost_norm > 1e-4 ? 1. / std::min(cost_norm, 1e4) : 1.;
+    for (auto& c: _c) {
+        c *= _cost_scaling;
+    }
+}
+
+void ADMMConicSolver::transpose() {
+    size_t const num_rows = _conic_form->num_rows();
+    size_t const num_columns = _conic_form->num_columns();
+    _column_starts.assign(num_columns + 1, 0);
+    for (auto const column: _column_indices) {
+        ++_column_starts[column + 1];
+    }
+    for (size_t j = 0; j < num_columns; ++j) {
+        _column_starts[j + 1] += _column_starts[j];
+    }
+    _row_indices.resize(_column_indices.size());
+    _transposed_values.resize(_values.size());
+    std::vector<int> next_positions(_column_starts.begin(), _column_starts.end() - 1);
+    for (size_t r = 0; r < num_rows; ++r) {
+        for (int k = _row_starts[r]; k < _row_starts[r + 1]; ++k) {
+            int const position = next_positions[_column_indices[k]]++;
+            _row_indices[position] = int(r);
+            _transposed_values[position] = _values[k];
+        }
+    }
+}
+
+void ADMMConicSolver::update_preconditioner() {
+    size_t const num_columns = _conic_form->num_columns();
+    _preconditioner.assign(num_columns, _sigma);
+    for (size_t j = 0; j < num_columns; ++j) {
+        for (int k = _column_starts[j]; k < _column_starts[j + 1]; ++k) {
+            _preconditioner[j] += _rhos[_row_indices[k]] * _transposed_values[k] * _transposed_values[k];
+        }
+    }
+}
+
+void ADMMConicSolver::multiply(std::vector<double> const& x, std::vector<double>& result) const {
+    result.resize(_row_starts.size() - 1);
+    for (size_t r = 0; r + 1 < _row_starts.size(); ++r) {
+        double val = 0;
+        for (int k = _row_starts[r]; k < _row_starts[r + 1]; ++k) {
+            val += _values[k] * x[_column_indices[k]];
+        }
+        result[r] = val;
+    }
+}
+
+void ADMMConicSolver::multiply_transposed(std::vector<double> const& y, std::vector<double>& result) const {
+    result.resize(_column_starts.size() - 1);
+    for (size_t j = 0; j + 1 < _column_starts.size(); ++j) {
+        double val = 0;
+        for (int k = _column_starts[j]; k < _column_starts[j + 1]; ++k) {
+            val += _transposed_values[k] * y[_row_indices[k]];
+        }
+        result[j] = val;
+    }
+}
+
+void ADMMConicSolver::solve_linear_system(std::vector<double> const& rhs, std::vector<double>& x, double tolerance) {
+    size_t const num_columns = x.size();
+    size_t const max_cg_iterations = std::max<size_t>(num_columns, 10);
+    std::vector<double> residual(num_columns), direction(num_columns), product(num_columns), row_product;
+    auto const apply = [&](std::vector<double> const& in, std::vector<double>& out) {
+        multiply(in, row_product);
+        for (size_t i = 0; i < row_product.size(); ++i) {
+            row_product[i] *= _rhos[i];
+        }
+        multiply_transposed(row_product, out);
+        for (size_t j = 0; j < num_columns; ++j) {
+            out[j] += _sigma * in[j];
+        }
+    };
+    auto const dot = [](std::vector<double> const& lhs, std::vector<double> const& rhs) {
+        double val = 0;
+        for (size_t j = 0; j < lhs.size(); ++j) {
+            val += lhs[j] * rhs[j];
+        }
+        return val;
+    };
+
+    apply(x, product);
+    for (size_t j = 0; j < num_columns; ++j) {
+        residual[j] = rhs[j] - product[j];
+    }
+    if (std::sqrt(dot(residual, residual)) <= tolerance) {
+        return;
+    }
+    for (size_t j = 0; j < num_columns; ++j) {
+        direction[j] = residual[j] / _preconditioner[j];
+    }
+    double residual_product = dot(residual, direction);
+    for (size_t iteration = 0; iteration < max_cg_iterations; ++iteration) {
+        apply(direction, product);
+        double const step = residual_product / dot(direction, product);
+        for (size_t j = 0; j < num_columns; ++j) {
+            x[j] += step * direction[j];
+            residual[j] -= step * product[j];
+        }
+        if (std::sqrt(dot(residual, residual)) <= tolerance) {
+            return;
+        }
+        double new_residual_product = 0;
+        for (size_t j = 0; j < num_columns; ++j) {
+            new_residual_product += residual[j] * residual[j] / _preconditioner[j];
+        }
+        double const beta = new_residual_product / residual_product;
+        residual_product = new_residual_product;
+        for (size_t j = 0; j < num_columns; ++j) {
+            direction[j] = residual[j] / _preconditioner[j] + beta * direction[j];
+        }
+    }
+}
+
+void ADMMConicSolver::project_onto_cone(std::vector<double>& v) const {
+    size_t const num_zero_rows = _conic_form->num_zero_rows();
+    size_t const num_linear_rows = num_zero_rows + _conic_form->num_nonnegative_rows();
+    std::fill(v.begin(), v.begin() + long(num_zero_rows), 0.);
+    for (size_t i = num_zero_rows; i < num_linear_rows; ++i) {
+        v[i] = std::max(v[i], 0.);
+    }
+    size_t cone_start = num_linear_rows;
+    for (auto const cone_size: _conic_form->second_order_cone_sizes()) {
+        double const t = v[cone_start];
+        double norm = 0;
+        for (size_t i = cone_start + 1; i < cone_start + cone_size; ++i) {
+            norm += v[i] * v[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm > t) {
+            double const scale = norm <= -t ? 0. : (norm + t) / (2 * norm);
+            v[cone_start] = scale * norm;
+            for (size_t i = cone_start + 1; i < cone_start + cone_size; ++i) {
+                v[i] *= scale;
+            }
+        }
+        cone_start += cone_size;
+    }
+}
+
+void ADMMConicSolver::solve_implementation() {
+    static const double relaxation = 1.6;
+    static const size_t check_interval = 10;
+    static const size_t rho_update_interval = 50;
+
+    set_status(SolverBase::Status::UNSOLVED);
+    auto const start = std::chrono::steady_clock::now();
+    size_t const num_rows = _conic_form->num_rows();
+    size_t const num_columns = _conic_form->num_columns();
+    std::vector<double> x_tilde(_x), s_tilde(num_rows), rhs(num_columns), row_buffer(num_rows), ax, aty;
+    bool converged = false;
+    bool time_limit_reached = false;
+    bool interrupted = false;
+    for (_iterations = 1; _iterations <= _max_iterations; ++_iterations) {
+        if (cancel_requested()) {
+            interrupted = true;
+            break;
+        }
+        // x_tilde = argmin c^T x + sigma/2 ||x - x_k||^2 + 1/2 ||b - A x - s_k + y_k / rho||_R^2
+        for (size_t i = 0; i < num_rows; ++i) {
+            row_buffer[i] = _rhos[i] * (_b[i] - _s[i]) + _y[i];
+        }
+        multiply_transposed(row_buffer, rhs);
+        double rhs_norm = 0;
+        for (size_t j = 0; j < num_columns; ++j) {
+            rhs[j] += _sigma * _x[j] - _c[j];
+            rhs_norm += rhs[j] * rhs[j];
+        }
+        double const cg_tolerance = std::max(1e-12, 1e-2 * std::sqrt(rhs_norm) / std::pow(double(_iterations), 1.5));
+        solve_linear_system(rhs, x_tilde, cg_tolerance);
+        multiply(x_tilde, s_tilde);
+
+        for (size_t j = 0; j < num_columns; ++j) {
+            _x[j] = relaxation * x_tilde[j] + (1 - relaxation) * _x[j];
+        }
+        for (size_t i = 0; i < num_rows; ++i) {
+            s_tilde[i] = relaxation * (_b[i] - s_tilde[i]) + (1 - relaxation) * _s[i];
+            row_buffer[i] = s_tilde[i] + _y[i] / _rhos[i];
+        }
+        project_onto_cone(row_buffer);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _y[i] += _rhos[i] * (s_tilde[i] - row_buffer[i]);
+            _s[i] = row_buffer[i];
+        }
+
+        if (_iterations % check_interval != 0) {
+            continue;
+        }
+        // residuals of the unscaled problem
+        multiply(_x, ax);
+        multiply_transposed(_y, aty);
+        double primal_residual = 0, primal_norm = 0, dual_residual = 0, dual_norm = 0;
+        for (size_t i = 0; i < num_rows; ++i) {
+            primal_residual = std::max(primal_residual, std::abs(ax[i] + _s[i] - _b[i]) / _row_scaling[i]);
+            primal_norm = std::max({primal_norm, std::abs(ax[i]) / _row_scaling[i], std::abs(_s[i]) / _row_scaling[i],
+                                    std::abs(_b[i]) / _row_scaling[i]});
+        }
+        for (size_t j = 0; j < num_columns; ++j) {
+            double const unscaling = 1. / (_column_scaling[j] * _cost_scaling);
+            dual_residual = std::max(dual_residual, std::abs(_c[j] - aty[j]) * unscaling);
+            dual_norm = std::max({dual_norm, std::abs(_c[j]) * unscaling, std::abs(aty[j]) * unscaling});
+        }
+        if (primal_residual <= _tolerance * (1 + primal_norm) and dual_residual <= _tolerance * (1 + dual_norm)) {
+            converged = true;
+            break;
+        }
+        double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (has_progress_callback()) {
+            // c' = cost_scaling * D c  and  x' = D^-1 x  give  c^T x = c'^T x' / cost_scaling
+            double objective = 0;
+            for (size_t j = 0; j < num_columns; ++j) {
+                objective += _c[j] * _x[j] / _cost_scaling;
+            }
+            // y lies in the polar cone after every iteration, so b^T y bounds c^T x once A^T y = c holds,
+            // which the iterate only satisfies up to the tolerance, so the bound keeps a margin of the same size
+            double dual_objective = 0;
+            for (size_t i = 0; i < num_rows; ++i) {
+                dual_objective += _b[i] * _y[i] / _cost_scaling;
+            }
+            double const objective_sign = _conic_form->maximize() ? -1. : 1.;
+            double const bound = objective_sign * dual_objective + _conic_form->objective_constant();
+            Progress progress{elapsed, objective_sign * objective + _conic_form->objective_constant(), {},
+                              primal_residual, dual_residual};
+            progress.set_interior_point_bound(bound - objective_sign * _tolerance * (1 + std::abs(bound)),
+                                              dual_residual, _tolerance * (1 + dual_norm));
+            report_progress(progress);
+        }
+        if (has_runtime_limit() and elapsed > runtime_limit()) {
+            time_limit_reached = true;
+            break;
+        }
+        if (_iterations % rho_update_interval == 0) {
+            double const ratio = std::sqrt((primal_residual / std::max(primal_norm, 1e-10)) /
+                                           std::max(dual_residual / std::max(dual_norm, 1e-10), 1e-10));
+            if (ratio > 5 or ratio < 0.2) {
+                _rho = std::clamp(_rho * ratio, 1e-6, 1e6);
+                for (size_t i = 0; i < num_rows; ++i) {
+                    _rhos[i] = i < _conic_form->num_zero_rows() ? 1e3 * _rho : _rho;
+                }
+                update_preconditioner();
+            }
+        }
+    }
+    _iterations = std::min(_iterations, _max_iterations);
+
+    _solution_values.resize(num_columns);
+    for (size_t j = 0; j < num_columns; ++j) {
+        _solution_values[j] = _column_scaling[j] * _x[j];
+    }
+    _slacks.resize(num_rows);
+    _dual_values.resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _slacks[i] = _s[i] / _row_scaling[i];
+        _dual_values[i] = _row_scaling[i] * _y[i] / _cost_scaling;
+    }
+
+    if (converged) {
+        set_status(SolverBase::Status::OPTIMAL);
+    } else if (time_limit_reached) {
+        set_status(SolverBase::Status::TIME_LIMIT);
+    } else if (interrupted) {
+        set_status(SolverBase::Status::INTERRUPTED);
+    }
+    helpers::warning_check(status() != SolverBase::Status::UNSOLVED,
+                           "ADMM did not converge within " + std::to_string(_max_iterations) + " iterations!");
+    transfer_solution_to_soc_model();
+    if (has_solution()) {
+        set_runtime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        set_objective_value(soc_model().objective().value());
+    }
+}
+
+void ADMMConicSolver::transfer_solution_to_soc_model() {
+    if (not has_solution()) {
+        non_const_soc_model().invalidate_solution();
+        return;
+    }
+    non_const_soc_model().set_solution(*this);
+    if (not soc_model().all_affine()) {
+        return;
+    }
+    // same sign convention as gurobi: the dual is the derivative of the objective with respect to the rhs
+    double const objective_sign = _conic_form->maximize() ? -1. : 1.;
+    auto const& constraints = soc_model().soc_constraints();
+    std::vector<double> dual_values(constraints.size());
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        dual_values[i] = objective_sign * _conic_form->constraint_row_signs()[i]
+                         * _dual_values[_conic_form->constraint_rows()[i]];
+    }
+    non_const_soc_model().set_dual_soc_constraint_values(dual_values);
+
+    std::vector<double> reduced_costs(soc_model().variables().size(), 0.);
+    for (auto const& svar: soc_model().objective().expression().linear().scaled_variables()) {
+        reduced_costs[svar.variable().raw_id()] += svar.scale();
+    }
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        for (auto const& svar: constraints[i].soc_expression().affine().linear().scaled_variables()) {
+            reduced_costs[svar.variable().raw_id()] -= svar.scale() * dual_values[i];
+        }
+    }
+    non_const_soc_model().set_reduced_costs(reduced_costs);
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef ROBUSTOPTIMIZATION_ADMMCONICSOLVER_H
+#define ROBUSTOPTIMIZATION_ADMMCONICSOLVER_H
+
+#include <memory>
+#include <vector>
+
+#include "SOCSolverBase.h"
+#include "../../models/SOCConicForm.h"
+
+namespace solvers {
+
+// Operator splitting solver for continuous LP and SOC models, which needs no external library.
+// Solves the conic form  min c^T x  s.t.  A x + s = b,  s in K  by ADMM on the equilibrated problem.
+// The linear systems (sigma I + A^T R A) x = r are solved by Jacobi preconditioned conjugate gradients.
+// Infeasibility is not detected, such models end as UNSOLVED after the iteration limit.
+// Progress reports carry the dual objective as bound, once the iterate is dual feasible within the tolerance.
+// The tuning parameters of SolverBase (threads, method, presolve, ...) do not apply and are ignored.
+class ADMMConicSolver : public SOCSolverBase {
+public:
+    explicit ADMMConicSolver(robust_model::SOCModel& soc_model);
+
+    double value(robust_model::SOCVariable::Index const& id) const final;
+
+    // absolute and relative tolerance on the primal and dual residuals
+    void set_tolerance(double tolerance);
+
+    void set_max_iterations(size_t max_iterations);
+
+    size_t iterations() const;
+
+private:
+    void solve_implementation() final;
+
+    void update_implementation() final;
+
+    void equilibrate();
+
+    void transpose();
+
+    void update_preconditioner();
+
+    // result = A x, or result = A^T y, of the equilibrated problem
+    void multiply(std::vector<double> const& x, std::vector<double>& result) const;
+    void multiply_transposed(std::vector<double> const& y, std::vector<double>& result) const;
+
+    // solves (sigma I + A^T R A) x = rhs starting from x
+    void solve_linear_system(std::vector<double> const& rhs, std::vector<double>& x, double tolerance);
+
+    void project_onto_cone(std::vector<double>& v) const;
+
+    void transfer_solution_to_soc_model();
+
+private:
+    double _tolerance = 1e-5;
+    size_t _max_iterations = 100000;
+    size_t _iterations = 0;
+
+    std::unique_ptr<robust_model::SOCConicForm> _conic_form;
+
+    // equilibrated problem  (E A D) x' + s' = E b,  with objective  cost_scaling * D c
+    std::vector<int> _row_starts;
+    std::vector<int> _column_indices;
+    std::vector<double> _values;
+    std::vector<int> _column_starts;
+    std::vector<int> _row_indices;
+    std::vector<double> _transposed_values;
+    std::vector<double> _b;
+    std::vector<double> _c;
+    std::vector<double> _row_scaling;
+    std::vector<double> _column_scaling;
+    double _cost_scaling = 1.;
+
+    // step sizes, equality rows get a larger step size
+    double _sigma = 1e-6;
+    double _rho = 0.1;
+    std::vector<double> _rhos;
+    std::vector<double> _preconditioner;
+
+    // iterates of the equilibrated problem
+    std::vector<double> _x;
+    std::vector<double> _s;
+    std::vector<double> _y;
+
+    // unscaled results of the last solve, also used as warm start
+    std::vector<double> _solution_values;
+    std::vector<double> _slacks;
+    std::vector<double> _dual_values;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_ADMMCONICSOLVER_H
@@ -0,0 +1,83 @@
+#include "GurobiEnvironmentPool.h"
+
+namespace solvers {
+
+GurobiEnvironmentPool::Lease::Lease(GurobiEnvironmentPool& pool, std::unique_ptr<GRBEnv> environment) :
+        _pool(pool), _environment(std::move(environment)) {}
+
+GurobiEnvironmentPool::Lease::~Lease() {
+    _pool.give_back(std::move(_environment));
+}
+
+GRBEnv& GurobiEnvironmentPool::Lease::environment() const {
+    return *_environment;
+}
+
+GurobiEnvironmentPool::GurobiEnvironmentPool(size_t max_idle_environments) :
+        _max_idle_environments(max_idle_environments) {}
+
+std::unique_ptr<GurobiEnvironmentPool::Lease> GurobiEnvironmentPool::borrow() {
+    GurobiEnvironmentParameters parameters;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (not _idle_environments.empty()) {
+            auto environment = std::move(_idle_environments.back());
+            _idle_environments.pop_back();
+            return std::make_unique<Lease>(*this, std::move(environment));
+        }
+        parameters = _parameters;
+    }
+    // starting an environment checks out a license, which should not block other borrowers
+    auto environment = std::make_unique<GRBEnv>(true);
+    apply_parameters(*environment, parameters);
+    environment->start();
+    return std::make_unique<Lease>(*this, std::move(environment));
+}
+
+void GurobiEnvironmentPool::set_parameters(GurobiEnvironmentParameters const& parameters) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _parameters = parameters;
+    for (auto& environment: _idle_environments) {
+        apply_parameters(*environment, _parameters);
+    }
+}
+
+GurobiEnvironmentParameters GurobiEnvironmentPool::parameters() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _parameters;
+}
+
+void GurobiEnvironmentPool::set_max_idle_environments(size_t max_idle_environments) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _max_idle_environments = max_idle_environments;
+    if (_idle_environments.size() > _max_idle_environments) {
+        _idle_environments.resize(_max_idle_environments);
+    }
+}
+
+size_t GurobiEnvironmentPool::num_idle_environments() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _idle_environments.size();
+}
+
+void GurobiEnvironmentPool::give_back(std::unique_ptr<GRBEnv> environment) {
+    if (not environment) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_idle_environments.size() < _max_idle_environments) {
+        // parameters might have changed while the environment was lent out
+        apply_parameters(*environment, _parameters);
+        _idle_environments.emplace_back(std::move(environment));
+    }
+}
+
+void GurobiEnvironmentPool::apply_parameters(GRBEnv& environment, GurobiEnvironmentParameters const& parameters) {
+    environment.set(GRB_IntParam_LogToConsole, parameters.log_to_console);
+    environment.set(GRB_IntParam_Threads, parameters.threads);
+    environment.set(GRB_DoubleParam_MIPGap, parameters.mip_gap);
+}
+
+GurobiEnvironmentPool global_gurobi_environment_pool;
+
+}
@@ -0,0 +1,69 @@
+#ifndef ROBUSTOPTIMIZATION_GUROBIENVIRONMENTPOOL_H
+#define ROBUSTOPTIMIZATION_GUROBIENVIRONMENTPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "gurobi_c++.h"
+
+namespace solvers {
+
+struct GurobiEnvironmentParameters {
+    int log_to_console = 0;
+    int threads = 1;
+    double mip_gap = 0.01;
+};
+
+// Thread safe pool of started Gurobi environments.
+// An environment is lent out exclusively and is given back to the pool, when its lease is destroyed.
+// Borrowing from an empty pool starts a new environment, at most max_idle_environments are kept for reuse.
+class GurobiEnvironmentPool {
+public:
+    class Lease {
+    public:
+        Lease(GurobiEnvironmentPool& pool, std::unique_ptr<GRBEnv> environment);
+
+        Lease(Lease const&) = delete;
+        Lease& operator=(Lease const&) = delete;
+
+        ~Lease();
+
+        GRBEnv& environment() const;
+
+    private:
+        GurobiEnvironmentPool& _pool;
+        std::unique_ptr<GRBEnv> _environment;
+    };
+
+public:
+    explicit GurobiEnvironmentPool(size_t max_idle_environments = 16);
+
+    std::unique_ptr<Lease> borrow();
+
+    // applies to all idle environments and to every environment borrowed afterwards
+    void set_parameters(GurobiEnvironmentParameters const& parameters);
+
+    GurobiEnvironmentParameters parameters() const;
+
+    void set_max_idle_environments(size_t max_idle_environments);
+
+    size_t num_idle_environments() const;
+
+private:
+    void give_back(std::unique_ptr<GRBEnv> environment);
+
+    static void apply_parameters(GRBEnv& environment, GurobiEnvironmentParameters const& parameters);
+
+private:
+    mutable std::mutex _mutex;
+    GurobiEnvironmentParameters _parameters;
+    size_t _max_idle_environments;
+    std::vector<std::unique_ptr<GRBEnv>> _idle_environments;
+};
+
+extern GurobiEnvironmentPool global_gurobi_environment_pool;
+
+}
+
+#endif //ROBUSTOPTIMIZATION_GUROBIENVIRONMENTPOOL_H
@@ -1,6 +1,11 @@
 #include "GurobiSOCSolver.h"
 #include "../../models/SOCModel.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+
 namespace solvers {
 
 GurobiSOCSolver::GurobiSOCSolver(robust_model::SOCModel& soc_model) :
@@ -10,11 +15,14 @@ GurobiSOCSolver::GurobiSOCSolver(robust_model::SOCModel& soc_model) :
 void GurobiSOCSolver::solve_implementation() {
     try {
         set_status(SolverBase::Status::UNSOLVED);
+        _grb_callback->set_optimality_tolerance(gurobi_model().getEnv().get(GRB_DoubleParam_OptimalityTol));
         _grb_model->optimize();
         if (gurobi_model().get(GRB_IntAttr_Status) == GRB_OPTIMAL)
             set_status(SolverBase::Status::OPTIMAL);
         if (gurobi_model().get(GRB_IntAttr_Status) == GRB_TIME_LIMIT)
             set_status(SolverBase::Status::TIME_LIMIT);
+        if (gurobi_model().get(GRB_IntAttr_Status) == GRB_INTERRUPTED)
+            set_status(SolverBase::Status::INTERRUPTED);
     } catch (GRBException e) {
         if (e.getErrorCode() == GRB_ERROR_OUT_OF_MEMORY) {
             set_status(SolverBase::Status::MEMORY_LIMIT);
@@ -36,12 +44,12 @@ void GurobiSOCSolver::solve_implementation() {
 }
 
 void GurobiSOCSolver::build_implementation() {
-    _grb_env = std::make_unique<GRBEnv>(true);
-    _grb_env->set(GRB_IntParam_LogToConsole, 0);
-    _grb_env->set(GRB_IntParam_Threads, 1);
-    _grb_env->set(GRB_DoubleParam_MIPGap, 0.01);
-    _grb_env->start();
-    _grb_model = std::make_unique<GRBModel>(*_grb_env);
+    // a previous model has to be freed before its environment is given back to the pool
+    _grb_model.reset();
+    _grb_env = global_gurobi_environment_pool.borrow();
+    _grb_model = std::make_unique<GRBModel>(_grb_env->environment());
+    _grb_callback = std::make_unique<Callback>(*this);
+    _grb_model->setCallback(_grb_callback.get());
     _grb_vars = std::make_unique<std::vector<GRBVar>>();
 }
 
@@ -50,41 +58,126 @@ void GurobiSOCSolver::update_implementation() {
         gurobi_model().set(GRB_DoubleParam_TimeLimit, runtime_limit());
     if (has_memory_limit())
         gurobi_model().set(GRB_DoubleParam_MemLimit, memory_limit());
+    update_parameters();
+
+    auto const transfer_start = std::chrono::steady_clock::now();
     update_variables();
+    update_coefficients();
     update_soc_constraints();
     update_sos_constraints();
     update_objectives();
+    update_start_values();
 
     gurobi_model().update();
+    set_model_transfer_time(model_transfer_time() + std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - transfer_start).count());
+    set_model_size({size_t(gurobi_model().get(GRB_IntAttr_NumVars)),
+                    size_t(gurobi_model().get(GRB_IntAttr_NumConstrs)),
+                    size_t(gurobi_model().get(GRB_IntAttr_NumQConstrs))});
+}
+
+void GurobiSOCSolver::update_parameters() {
+    auto const& params = parameters();
+    if (params.threads.has_value())
+        gurobi_model().set(GRB_IntParam_Threads, params.threads.value());
+    if (params.barrier_convergence_tolerance.has_value())
+        gurobi_model().set(GRB_DoubleParam_BarConvTol, params.barrier_convergence_tolerance.value());
+    if (params.barrier_qcp_convergence_tolerance.has_value())
+        gurobi_model().set(GRB_DoubleParam_BarQCPConvTol, params.barrier_qcp_convergence_tolerance.value());
+    if (params.seed.has_value())
+        gurobi_model().set(GRB_IntParam_Seed, params.seed.value());
+    gurobi_model().set(GRB_IntParam_Method, to_grb_method(params.method));
+    gurobi_model().set(GRB_IntParam_Crossover, params.crossover ? -1 : 0);
+    gurobi_model().set(GRB_IntParam_Presolve, to_grb_presolve(params.presolve));
 }
 
 void GurobiSOCSolver::update_variables() {
-    for (auto const& var: variables_to_add_grb()) {
-        _grb_vars->emplace_back(gurobi_model().addVar(var.lb(), var.ub(), 0, to_grb_type(var.type())));
+    auto const new_vars = variables_to_add_grb();
+    int const num_new_vars = int(soc_model().variables().size() - _grb_next_var_to_add);
+    if (num_new_vars > 0) {
+        std::vector<double> lbs, ubs;
+        std::vector<char> types;
+        lbs.reserve(num_new_vars);
+        ubs.reserve(num_new_vars);
+        types.reserve(num_new_vars);
+        for (auto const& var: new_vars) {
+            lbs.emplace_back(var.lb());
+            ubs.emplace_back(var.ub());
+            types.emplace_back(to_grb_type(var.type()));
+        }
+        std::unique_ptr<GRBVar[]> const added_vars(
+                gurobi_model().addVars(lbs.data(), ubs.data(), nullptr, types.data(), nullptr, num_new_vars));
+        _grb_vars->insert(_grb_vars->end(), added_vars.get(), added_vars.get() + num_new_vars);
     }
     _grb_next_var_to_add = soc_model().variables().size();
     gurobi_model().update();
 }
 
+void GurobiSOCSolver::update_coefficients() {
+    for (auto const& change: soc_model().coefficient_changes()) {
+        // constraints, which are not transferred yet, already contain the change
+        if (change.constraint_number < _grb_next_constr_to_add) {
+            gurobi_model().chgCoeff(_grb_constrs[change.constraint_number], (*_grb_vars)[change.variable.raw_id()],
+                                    change.value);
+        }
+    }
+    non_const_soc_model().clear_coefficient_changes();
+}
+
+void GurobiSOCSolver::update_start_values() {
+    // the simplex starts from the primal values of continuous models, the mip search from the start solution
+    auto const attribute = soc_model().is_continuous() ? GRB_DoubleAttr_PStart : GRB_DoubleAttr_Start;
+    for (auto const& start: soc_model().start_values()) {
+        (*_grb_vars)[start.variable.raw_id()].set(attribute, start.value);
+    }
+    non_const_soc_model().clear_start_values();
+}
+
+void GurobiSOCSolver::add_linear_rows(robust_model::SparseLinearRows const& rows, std::vector<std::string> const& names,
+                                      size_t const first_constraint_number) {
+    if (rows.empty()) {
+        return;
+    }
+    int const num_rows = int(rows.num_rows());
+    std::vector<GRBVar> row_vars;
+    row_vars.reserve(rows.num_nonzeros());
+    for (auto const column: rows.column_indices()) {
+        row_vars.emplace_back((*_grb_vars)[column]);
+    }
+    std::vector<GRBLinExpr> exprs(num_rows);
+    std::vector<char> senses;
+    senses.reserve(num_rows);
+    for (int r = 0; r < num_rows; ++r) {
+        int const row_start = rows.row_starts()[r];
+        exprs[r].addTerms(rows.values().data() + row_start, row_vars.data() + row_start,
+                          rows.row_starts()[r + 1] - row_start);
+        senses.emplace_back(to_grb_sense(rows.senses()[r]));
+    }
+    std::unique_ptr<GRBConstr[]> const added_constrs(
+            gurobi_model().addConstrs(exprs.data(), senses.data(), rows.rhs().data(), names.data(), num_rows));
+    std::copy(added_constrs.get(), added_constrs.get() + num_rows, _grb_constrs.begin() + first_constraint_number);
+}
+
 void GurobiSOCSolver::update_soc_constraints() {
+    // consecutive affine constraints are collected and transferred as one sparse block,
+    // so that the Gurobi constraint order matches the order of the soc model
+    robust_model::SparseLinearRows rows;
+    std::vector<std::string> names;
+    _grb_constrs.resize(soc_model().soc_constraints().size());
+    size_t constraint_number = _grb_next_constr_to_add;
     for (auto const& constr: soc_constraints_to_add_grb()) {
+        ++constraint_number;
         if (constr.soc_expression().is_affine()) {
-            gurobi_model().addConstr(to_gurobi_linear(constr.soc_expression().affine()),
-                                     to_grb_sense(constr.sense()), 0,
-                                     constr.name()
-            );
+            rows.add_row(constr.soc_expression().affine(), constr.sense());
+            names.emplace_back(constr.name());
             continue;
         }
+        add_linear_rows(rows, names, constraint_number - 1 - rows.num_rows());
+        rows.clear();
+        names.clear();
         switch (constr.soc_expression().normed_vector().norm_type()) {
             case robust_model::VectorNormType::Two: {
-                auto expr = GRBQuadExpr();
-                for (auto const& affine: constr.soc_expression().normed_vector().normed_vector()) {
-                    auto const lin_expr = to_gurobi_linear(affine);
-                    expr += lin_expr * lin_expr;
-                }
-                auto const lin_expr = to_gurobi_linear(constr.soc_expression().affine());
-                gurobi_model().addQConstr(expr, to_grb_sense(constr.sense()), lin_expr * lin_expr, constr.name());
-                gurobi_model().addConstr(lin_expr <= 0, constr.name() + "_pos");
+                add_two_norm_constraint(constr);
                 continue;
             }
             case robust_model::VectorNormType::One: {
@@ -110,9 +203,89 @@ void GurobiSOCSolver::update_soc_constraints() {
             }
         }
     }
+    add_linear_rows(rows, names, constraint_number - rows.num_rows());
     _grb_next_constr_to_add = soc_model().soc_constraints().size();
 }
 
+void GurobiSOCSolver::add_two_norm_constraint(robust_model::SOCConstraint<robust_model::SOCVariable> const& constr) {
+    switch (soc_encoding()) {
+        case SolverBase::SOCEncoding::NATIVE_CONE:
+            add_native_cone_constraint(constr);
+            return;
+        case SolverBase::SOCEncoding::SQUARED_QUADRATIC:
+            add_squared_quadratic_constraint(constr);
+            return;
+    }
+}
+
+void GurobiSOCSolver::add_native_cone_constraint(robust_model::SOCConstraint<robust_model::SOCVariable> const& constr) {
+    helpers::exception_check(constr.sense() == robust_model::ConstraintSense::LEQ,
+                             "Two norm constraint " + constr.name() + " is not convex!");
+    // an affine expression, which is +-x for a single variable x, does not need an auxiliary variable
+    std::vector<bool> used_in_cone;
+    auto const single_variable = [&](robust_model::AffineExpression<robust_model::SOCVariable::Reference> const& affine,
+                                     bool nonnegative) -> std::optional<size_t> {
+        auto const& svars = affine.linear().scaled_variables();
+        if (affine.constant() != 0 or svars.size() != 1 or std::abs(svars.front().scale()) != 1) {
+            return {};
+        }
+        size_t const id = svars.front().variable().raw_id();
+        if (nonnegative and (svars.front().scale() != -1 or soc_model().variables()[id].lb() < 0)) {
+            return {};
+        }
+        if (id < used_in_cone.size() and used_in_cone[id]) {
+            return {};
+        }
+        if (id >= used_in_cone.size()) {
+            used_in_cone.resize(id + 1, false);
+        }
+        used_in_cone[id] = true;
+        return id;
+    };
+
+    auto const& affine = constr.soc_expression().affine();
+    GRBVar t;
+    if (auto const id = single_variable(affine, true)) {
+        t = (*_grb_vars)[id.value()];
+    } else {
+        t = gurobi_model().addVar(0, robust_model::NO_VARIABLE_UB, 0, GRB_CONTINUOUS, constr.name() + "_t");
+        gurobi_model().addConstr(t + to_gurobi_linear(affine) == 0, constr.name() + "_t");
+    }
+
+    auto const& normed_vector = constr.soc_expression().normed_vector().normed_vector();
+    std::vector<GRBVar> cone_vars;
+    cone_vars.reserve(normed_vector.size() + 1);
+    for (size_t i = 0; i < normed_vector.size(); ++i) {
+        if (auto const id = single_variable(normed_vector[i], false)) {
+            cone_vars.emplace_back((*_grb_vars)[id.value()]);
+            continue;
+        }
+        std::string const name = constr.name() + "_y" + std::to_string(i);
+        auto const y = gurobi_model().addVar(robust_model::NO_VARIABLE_LB, robust_model::NO_VARIABLE_UB, 0,
+                                             GRB_CONTINUOUS, name);
+        gurobi_model().addConstr(y == to_gurobi_linear(normed_vector[i]), name);
+        cone_vars.emplace_back(y);
+    }
+    std::vector<double> coefficients(cone_vars.size(), 1.);
+    cone_vars.emplace_back(t);
+    coefficients.emplace_back(-1.);
+    GRBQuadExpr cone;
+    cone.addTerms(coefficients.data(), cone_vars.data(), cone_vars.data(), int(cone_vars.size()));
+    gurobi_model().addQConstr(cone, GRB_LESS_EQUAL, 0, constr.name());
+}
+
+void GurobiSOCSolver::add_squared_quadratic_constraint(
+        robust_model::SOCConstraint<robust_model::SOCVariable> const& constr) {
+    auto expr = GRBQuadExpr();
+    for (auto const& affine: constr.soc_expression().normed_vector().normed_vector()) {
+        auto const lin_expr = to_gurobi_linear(affine);
+        expr += lin_expr * lin_expr;
+    }
+    auto const lin_expr = to_gurobi_linear(constr.soc_expression().affine());
+    gurobi_model().addQConstr(expr, to_grb_sense(constr.sense()), lin_expr * lin_expr, constr.name());
+    gurobi_model().addConstr(lin_expr <= 0, constr.name() + "_pos");
+}
+
 void GurobiSOCSolver::update_sos_constraints() {
     for (auto const& constr: sos_constraints_to_add_grb()) {
         size_t const len = constr.exclusive_variables().size();
@@ -129,13 +302,19 @@ void GurobiSOCSolver::update_sos_constraints() {
 
 void GurobiSOCSolver::update_objectives() {
     static const int max_objectives = 100;
+    // replaced objectives are transferred again
+    if (_grb_objective_revision != soc_model().objective_revision()) {
+        gurobi_model().set(GRB_IntAttr_NumObj, 0);
+        _grb_next_obj_to_add = 0;
+        _grb_objective_revision = soc_model().objective_revision();
+    }
     if (soc_model().is_multi_objective()) {
         gurobi_model().set(GRB_IntAttr_ModelSense, to_grb_sense(soc_model().objective().sense()));
         gurobi_model().set(GRB_IntAttr_NumObj, int(soc_model().objectives().size()));
         for (size_t i = _grb_next_obj_to_add; i < soc_model().objectives().size(); ++i) {
             helpers::exception_check(
                     i < max_objectives, "Did not expect to get more than 100 objectives! "
-                                        "Adjust max_objectives when more are needed!");
+                                        "Use lexicographic reoptimization when more are needed!");
             gurobi_model().setObjectiveN(to_gurobi_linear(soc_model().objective(i).expression()), int(i),
                                          int(max_objectives - i));
         }
@@ -178,26 +357,83 @@ GRBModel& GurobiSOCSolver::gurobi_model() {
 
 void GurobiSOCSolver::transfer_solution_to_soc_model() {
     if (has_solution()) {
+        // the soc variables are the first variables of the gurobi model
+        int const num_vars = int(soc_model().variables().size());
+        std::unique_ptr<double[]> const solution_values(
+                gurobi_model().get(GRB_DoubleAttr_X, _grb_vars->data(), num_vars));
+        _solution_values.assign(solution_values.get(), solution_values.get() + num_vars);
         non_const_soc_model().set_solution(*this);
         if (soc_model().all_affine() and (not soc_model().is_multi_objective()) and soc_model().is_continuous()) {
-            std::vector<double> dual_values(soc_model().soc_constraints().size());
-            for (int i = 0; i < dual_values.size(); ++i) {
-                dual_values.at(i) = gurobi_model().getConstr(i).get(GRB_DoubleAttr_Pi);
-            }
-            non_const_soc_model().set_dual_soc_constraint_values(dual_values);
+            std::unique_ptr<double[]> const reduced_costs(
+                    gurobi_model().get(GRB_DoubleAttr_RC, _grb_vars->data(), num_vars));
+            _reduced_costs.assign(reduced_costs.get(), reduced_costs.get() + num_vars);
+            non_const_soc_model().set_reduced_costs(_reduced_costs);
+
+            int const num_constrs = int(soc_model().soc_constraints().size());
+            std::unique_ptr<GRBConstr[]> const constrs(gurobi_model().getConstrs());
+            std::unique_ptr<double[]> const dual_values(gurobi_model().get(GRB_DoubleAttr_Pi, constrs.get(), num_constrs));
+            _dual_values.assign(dual_values.get(), dual_values.get() + num_constrs);
+            non_const_soc_model().set_dual_soc_constraint_values(_dual_values);
         }
     } else {
+        _solution_values.clear();
+        _reduced_costs.clear();
+        _dual_values.clear();
         non_const_soc_model().invalidate_solution();
     }
 }
 
 double GurobiSOCSolver::value(robust_model::SOCVariable::Index const& id) const {
     helpers::exception_check(has_solution(), "Only extract solution, when it exists!");
-    return _grb_vars->at(id.raw_id()).get(GRB_DoubleAttr_X);
+    return _solution_values.at(id.raw_id());
 }
 
 void GurobiSOCSolver::objectives_reset() {
     _grb_next_obj_to_add = 0;
 }
 
+GurobiSOCSolver::Callback::Callback(GurobiSOCSolver& solver) : _solver(solver) {}
+
+void GurobiSOCSolver::Callback::set_optimality_tolerance(double const optimality_tolerance) {
+    _optimality_tolerance = optimality_tolerance;
+}
+
+void GurobiSOCSolver::Callback::callback() {
+    if (_solver.cancel_requested()) {
+        abort();
+        return;
+    }
+    if (not _solver.has_progress_callback()) {
+        return;
+    }
+    Progress progress;
+    switch (where) {
+        case GRB_CB_SIMPLEX:
+            progress.objective_value = getDoubleInfo(GRB_CB_SPX_OBJVAL);
+            progress.primal_residual = getDoubleInfo(GRB_CB_SPX_PRIMINF);
+            progress.dual_residual = getDoubleInfo(GRB_CB_SPX_DUALINF);
+            break;
+        case GRB_CB_BARRIER:
+            progress.objective_value = getDoubleInfo(GRB_CB_BARRIER_PRIMOBJ);
+            progress.primal_residual = getDoubleInfo(GRB_CB_BARRIER_PRIMINF);
+            progress.dual_residual = getDoubleInfo(GRB_CB_BARRIER_DUALINF);
+            // the optimality tolerance is the dual feasibility tolerance of gurobi
+            progress.set_interior_point_bound(getDoubleInfo(GRB_CB_BARRIER_DUALOBJ), progress.dual_residual.value(),
+                                              _optimality_tolerance);
+            break;
+        case GRB_CB_MIP: {
+            // gurobi reports an infinite incumbent as long as none was found
+            double const incumbent = getDoubleInfo(GRB_CB_MIP_OBJBST);
+            if (std::abs(incumbent) < GRB_INFINITY)
+                progress.objective_value = incumbent;
+            progress.objective_bound = getDoubleInfo(GRB_CB_MIP_OBJBND);
+            break;
+        }
+        default:
+            return;
+    }
+    progress.runtime = getDoubleInfo(GRB_CB_RUNTIME);
+    _solver.report_progress(progress);
+}
+
 }
\ No newline at end of file
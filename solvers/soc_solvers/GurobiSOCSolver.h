@@ -1,8 +1,10 @@
 #ifndef ROBUSTOPTIMIZATION_GUROBISOCSOLVER_H
 #define ROBUSTOPTIMIZATION_GUROBISOCSOLVER_H
 
-#include "gurobi_c++.h"
+#include "gurobi_types.h"
 #include "SOCSolverBase.h"
+#include "GurobiEnvironmentPool.h"
+#include "../../models/basic_model_objects/SparseLinearRows.h"
 
 
 namespace robust_model{
@@ -17,10 +19,26 @@ class GurobiSOCSolver : public SOCSolverBase{
 public:
     explicit GurobiSOCSolver(robust_model::SOCModel& soc_model);
 
-    double value(robust_model::SOCVariable::Index const& id) const;
+    double value(robust_model::SOCVariable::Index const& id) const final;
 
     void objectives_reset();
 
+private:
+    // reports the progress of simplex, barrier and branch and bound and aborts the solve on a cancel request
+    class Callback : public GRBCallback {
+    public:
+        explicit Callback(GurobiSOCSolver& solver);
+
+        void set_optimality_tolerance(double optimality_tolerance);
+
+    protected:
+        void callback() final;
+
+    private:
+        GurobiSOCSolver& _solver;
+        double _optimality_tolerance = 0;
+    };
+
 private:
     void solve_implementation() final;
 
@@ -30,10 +48,21 @@ private:
 
     GRBModel & gurobi_model();
 
+    void update_parameters();
+
     void update_variables();
+    void update_coefficients();
     void update_soc_constraints();
     void update_sos_constraints();
     void update_objectives();
+    void update_start_values();
+
+    void add_two_norm_constraint(robust_model::SOCConstraint<robust_model::SOCVariable> const& constr);
+    void add_native_cone_constraint(robust_model::SOCConstraint<robust_model::SOCVariable> const& constr);
+    void add_squared_quadratic_constraint(robust_model::SOCConstraint<robust_model::SOCVariable> const& constr);
+
+    void add_linear_rows(robust_model::SparseLinearRows const& rows, std::vector<std::string> const& names,
+                         size_t first_constraint_number);
 
     GRBLinExpr to_gurobi_linear(robust_model::AffineExpression<robust_model::SOCVariable::Reference> const& affine) const;
 
@@ -46,14 +75,24 @@ private:
 
 private:
 
-    std::unique_ptr<GRBEnv> _grb_env;
+    // declared before the model, so that the model is destroyed before its environment is given back
+    std::unique_ptr<GurobiEnvironmentPool::Lease> _grb_env;
     std::unique_ptr<GRBModel> _grb_model;
+    std::unique_ptr<Callback> _grb_callback;
     std::unique_ptr<std::vector<GRBVar>> _grb_vars;
+    // gurobi constraint of each affine soc constraint, others keep a default constraint
+    std::vector<GRBConstr> _grb_constrs;
+
+    // solution values, reduced costs and duals of the last solve, indexed like the soc model
+    std::vector<double> _solution_values;
+    std::vector<double> _reduced_costs;
+    std::vector<double> _dual_values;
 
     size_t _grb_next_var_to_add = 0;
     size_t _grb_next_constr_to_add = 0;
     size_t _grb_next_sos_constr_to_add = 0;
     size_t _grb_next_obj_to_add = 0;
+    size_t _grb_objective_revision = 0;
 };
 
 }
@@ -0,0 +1,45 @@
+#include "PresolvingSOCSolver.h"
+
+namespace solvers {
+
+PresolvingSOCSolver::PresolvingSOCSolver(SOCBackend const backend, robust_model::SOCModel& soc_model) :
+        SOCSolverBase(soc_model), _backend(backend) {}
+
+double PresolvingSOCSolver::value(robust_model::SOCVariable::Index const& id) const {
+    helpers::exception_check(has_solution(), "Only extract solution, when it exists!");
+    return soc_model().variables().at(id.raw_id()).solution();
+}
+
+robust_model::SOCPresolver::Statistics const& PresolvingSOCSolver::presolve_statistics() const {
+    helpers::exception_check(bool(_presolver), "The model was not presolved yet!");
+    return _presolver->statistics();
+}
+
+void PresolvingSOCSolver::update_implementation() {
+    // a failed update leaves the reduced model unusable
+    if (_presolver and not _presolver->update(soc_model())) {
+        _reduced_solver.reset();
+        _presolver.reset();
+    }
+    if (not _presolver) {
+        _presolver = std::make_unique<robust_model::SOCPresolver>(soc_model());
+        helpers::global_logger << _presolver->statistics().to_string();
+        _reduced_solver = SOCSolverBase::create(_backend, _presolver->reduced_model());
+    }
+    // the changes and start values are part of the reduced model now
+    non_const_soc_model().clear_coefficient_changes();
+    non_const_soc_model().clear_start_values();
+}
+
+void PresolvingSOCSolver::solve_implementation() {
+    set_parameters_to_other(*_reduced_solver);
+    _reduced_solver->solve();
+    set_results_from_other(*_reduced_solver);
+    if (has_solution()) {
+        _presolver->postsolve(non_const_soc_model());
+    } else {
+        non_const_soc_model().invalidate_solution();
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef ROBUSTOPTIMIZATION_PRESOLVINGSOCSOLVER_H
+#define ROBUSTOPTIMIZATION_PRESOLVINGSOCSOLVER_H
+
+#include <memory>
+
+#include "SOCSolverBase.h"
+#include "../../models/SOCPresolver.h"
+
+namespace solvers {
+
+// Presolves the SOCModel and hands the reduced model to another backend. The results are mapped back to the
+// original model. Updates are applied to the reduced model, so that the backend updates it in place and warm starts,
+// only changes invalidating a reduction presolve the model again and create a new backend.
+class PresolvingSOCSolver : public SOCSolverBase {
+public:
+    PresolvingSOCSolver(SOCBackend backend, robust_model::SOCModel& soc_model);
+
+    double value(robust_model::SOCVariable::Index const& id) const final;
+
+    robust_model::SOCPresolver::Statistics const& presolve_statistics() const;
+
+private:
+    void update_implementation() final;
+
+    void solve_implementation() final;
+
+private:
+    SOCBackend const _backend;
+    std::unique_ptr<robust_model::SOCPresolver> _presolver;
+    std::unique_ptr<SOCSolverBase> _reduced_solver;
+};
+
+}
+
+#endif //ROBUSTOPTIMIZATION_PRESOLVINGSOCSOLVER_H
@@ -1,4 +1,9 @@
 #include "SOCSolverBase.h"
+#include "ADMMConicSolver.h"
+#include "PresolvingSOCSolver.h"
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+#include "GurobiSOCSolver.h"
+#endif
 
 namespace solvers{
 
@@ -12,4 +17,24 @@ robust_model::SOCModel& SOCSolverBase::non_const_soc_model() {
 
 SOCSolverBase::SOCSolverBase(robust_model::SOCModel& soc_model) : _soc_model(soc_model) {}
 
+std::unique_ptr<SOCSolverBase> SOCSolverBase::create(SOCBackend backend, robust_model::SOCModel& soc_model,
+                                                     bool const presolve) {
+    if (presolve) {
+        return std::make_unique<PresolvingSOCSolver>(backend, soc_model);
+    }
+    switch (backend) {
+        case SOCBackend::GUROBI:
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+            return std::make_unique<GurobiSOCSolver>(soc_model);
+#else
+            helpers::exception_check(false, "Gurobi was not found at build time!");
+            return {};
+#endif
+        case SOCBackend::ADMM:
+            return std::make_unique<ADMMConicSolver>(soc_model);
+    }
+    helpers::exception_check(false, "Forbidden Case!");
+    return {};
+}
+
 }
@@ -1,15 +1,27 @@
 #ifndef ROBUSTOPTIMIZATION_SOCSOLVERBASE_H
 #define ROBUSTOPTIMIZATION_SOCSOLVERBASE_H
 
+#include <memory>
+
 #include "../SolverBase.h"
 #include "../../models/SOCModel.h"
 
 namespace solvers {
 
+// Interface of the backends solving a SOCModel, the results are written back to the model.
 class SOCSolverBase : public SolverBase{
 public:
     explicit SOCSolverBase(robust_model::SOCModel& soc_model);
 
+    virtual ~SOCSolverBase() = default;
+
+    // with presolve the backend solves the model reduced by SOCPresolver
+    static std::unique_ptr<SOCSolverBase> create(SOCBackend backend, robust_model::SOCModel& soc_model,
+                                                 bool presolve = false);
+
+    // solution value of a variable after a successful solve
+    virtual double value(robust_model::SOCVariable::Index const& id) const = 0;
+
 protected:
     robust_model::SOCModel const& soc_model() const;
     robust_model::SOCModel & non_const_soc_model();
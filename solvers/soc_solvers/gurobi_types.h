@@ -0,0 +1,84 @@
+#ifndef ROBUSTOPTIMIZATION_GUROBI_TYPES_H
+#define ROBUSTOPTIMIZATION_GUROBI_TYPES_H
+
+#include "gurobi_c++.h"
+#include "../../models/basic_model_objects/types_and_constants.h"
+#include "../SolverBase.h"
+
+namespace solvers {
+
+inline char to_grb_sense(robust_model::ConstraintSense s){
+    switch (s) {
+        case robust_model::ConstraintSense::GEQ:
+            return GRB_GREATER_EQUAL;
+        case robust_model::ConstraintSense::LEQ:
+            return GRB_LESS_EQUAL;
+        case robust_model::ConstraintSense::EQ:
+            return GRB_EQUAL;
+    }
+    return char();
+}
+
+inline int to_grb_sense(robust_model::ObjectiveSense sense){
+    switch (sense) {
+        case robust_model::ObjectiveSense::MIN:
+            return GRB_MINIMIZE;
+        case robust_model::ObjectiveSense::MAX:
+            return GRB_MAXIMIZE;
+        default:
+            helpers::exception_check(false, "Forbidden Case!");
+            return 0;
+    }
+}
+
+inline char to_grb_type(robust_model::VariableType sense){
+    switch (sense) {
+        case robust_model::VariableType::Continuous:
+            return GRB_CONTINUOUS;
+        case robust_model::VariableType::Binary:
+            return GRB_BINARY;
+        case robust_model::VariableType::Integer:
+            return GRB_INTEGER;
+        default:
+            helpers::exception_check(false, "Forbidden Case!");
+            return 0;
+    }
+}
+
+inline int to_grb_method(SolverBase::Parameters::Method method){
+    switch (method) {
+        case SolverBase::Parameters::Method::AUTOMATIC:
+            return -1;
+        case SolverBase::Parameters::Method::PRIMAL_SIMPLEX:
+            return 0;
+        case SolverBase::Parameters::Method::DUAL_SIMPLEX:
+            return 1;
+        case SolverBase::Parameters::Method::BARRIER:
+            return 2;
+        case SolverBase::Parameters::Method::CONCURRENT:
+            return 3;
+        default:
+            helpers::exception_check(false, "Forbidden Case!");
+            return -1;
+    }
+}
+
+inline int to_grb_presolve(SolverBase::Parameters::Presolve presolve){
+    switch (presolve) {
+        case SolverBase::Parameters::Presolve::AUTOMATIC:
+            return -1;
+        case SolverBase::Parameters::Presolve::OFF:
+            return 0;
+        case SolverBase::Parameters::Presolve::CONSERVATIVE:
+            return 1;
+        case SolverBase::Parameters::Presolve::AGGRESSIVE:
+            return 2;
+        default:
+            helpers::exception_check(false, "Forbidden Case!");
+            return -1;
+    }
+}
+
+}
+
+#endif //ROBUSTOPTIMIZATION_GUROBI_TYPES_H
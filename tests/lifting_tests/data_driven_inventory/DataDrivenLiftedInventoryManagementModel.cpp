@@ -84,10 +84,27 @@ void DataDrivenLiftedInventoryManagementModel::build_ro_model(DataModelBase::Sam
     );
 }
 
+void DataDrivenLiftedInventoryManagementModel::update_uncertainty_set(DataModelBase::SampleData const& training_data) {
+    auto const [lbs, ubs] = get_uncertainty_bounds(training_data);
+    for (auto const uvar: _model.uncertainty_variable_ids()) {
+        _model.set_uncertainty_variable_bounds(uvar, lbs.at(uvar.raw_id()), ubs.at(uvar.raw_id()));
+    }
+    // constants of uvar - (center - radius) >= 0 and uvar - (center + radius) <= 0 as added by build_ro_model
+    auto const& union_sets = _model.uncertainty_set().constraint_sets();
+    for (size_t i = 0; i < training_data.size(); ++i) {
+        for (size_t t = 0; t < training_data.at(i).size(); ++t) {
+            double const center = training_data.at(i).at(t);
+            _model.set_uncertainty_constraint_constant(union_sets.at(i), 2 * t, _radius - center);
+            _model.set_uncertainty_constraint_constant(union_sets.at(i), 2 * t + 1, -center - _radius);
+        }
+    }
+}
+
 void DataDrivenLiftedInventoryManagementModel::solve_ro_model(SampleData const& training_data) {
     switch (_mode) {
         case Mode::AFFINE:
             _affine_model = std::make_unique<robust_model::AffineAdjustablePolicySolver>(_model);
+            _affine_model->set_parametric_uncertainty_set(true);
             _affine_model->build();
             _affine_model->solve();
             break;
@@ -134,11 +151,30 @@ DataDrivenLiftedInventoryManagementModel::get_uncertainty_bounds(DataModelBase::
 }
 
 bool DataDrivenLiftedInventoryManagementModel::train(DataModelBase::SampleData const& training_data) {
+    _training_data = training_data;
     build_ro_model(training_data);
     solve_ro_model(training_data);
     return active_solver().has_solution();
 }
 
+bool DataDrivenLiftedInventoryManagementModel::can_retrain(double const radius) const {
+    return not _training_data.empty() and _radius > 0 and radius > 0;
+}
+
+bool DataDrivenLiftedInventoryManagementModel::retrain(double const radius) {
+    helpers::exception_check(can_retrain(radius), "Only retrain a model trained with positive radius for another "
+                                                  "positive radius!");
+    _radius = radius;
+    update_uncertainty_set(_training_data);
+    if (_mode == Mode::AFFINE) {
+        _affine_model->solve();
+    } else {
+        // the lifted counterpart depends on the uncertainty set in a non parametric way and is rebuilt
+        solve_ro_model(_training_data);
+    }
+    return active_solver().has_solution();
+}
+
 ScoreOutput DataDrivenLiftedInventoryManagementModel::test(DataModelBase::SampleData const& test_data) const {
     std::vector<double> objs;
     for (auto const& sample: test_data) {
@@ -45,6 +45,12 @@ public:
 
     bool train(SampleData const& training_data) final;
 
+    // radius 0 is modelled by equations instead of bounds, so only positive radii can be changed in place
+    bool can_retrain(double radius) const;
+
+    // trains again on the last training data with another radius, the affine policy is reoptimized in place
+    bool retrain(double radius);
+
     ScoreOutput test(SampleData const& test_data) const final;
 
     double train_time() const final;
@@ -52,6 +58,8 @@ public:
 private:
     void build_ro_model(SampleData const& training_data);
 
+    void update_uncertainty_set(SampleData const& training_data);
+
     solvers::SolverBase const& active_solver() const;
 
     std::tuple<std::vector<double>, std::vector<double>> get_uncertainty_bounds(SampleData const& training_data) const;
@@ -72,13 +80,15 @@ private:
 
 private:
     Mode const _mode;
-    double const _radius;
+    // changed by retrain
+    double _radius;
     size_t const _num_lifting_parts;
 
     std::unique_ptr<robust_model::AffineAdjustablePolicySolver> _affine_model;
     std::unique_ptr<robust_model::LiftingPolicySolver> _lifting_model;
 
     robust_model::ROModel _model;
+    SampleData _training_data;
 
     double const _max_order = 260;
     double const _order_cost = .1;
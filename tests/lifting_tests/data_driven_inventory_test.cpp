@@ -132,17 +132,24 @@ std::string test(Parameter const& parameter) {
                                   + std::to_string(model.best_radius()) + "; " + std::to_string(train_time) + "; "
                                   + train_score.csv_string() + "; " + test_score.csv_string() + "\n";
             } else {
+                std::unique_ptr<data_models::DataDrivenLiftedInventoryManagementModel> model;
                 for (double const diam: radii) {
-                    data_models::DataDrivenLiftedInventoryManagementModel model(mode, diam, overage_cost,
-                                                                                eoh_underage_cost,
-                                                                                4);
-                    if (not model.train(train_data)) {
+                    // the model of the previous radius is reoptimized in place, when the radius allows it
+                    bool trained;
+                    if (model and model->can_retrain(diam)) {
+                        trained = model->retrain(diam);
+                    } else {
+                        model = std::make_unique<data_models::DataDrivenLiftedInventoryManagementModel>(
+                                mode, diam, overage_cost, eoh_underage_cost, 4);
+                        trained = model->train(train_data);
+                    }
+                    if (not trained) {
                         success = false;
                         break;
                     }
-                    auto const train_time = model.train_time();
-                    auto const train_score = model.test(train_data);
-                    auto const test_score = model.test(test_data);
+                    auto const train_time = model->train_time();
+                    auto const train_score = model->test(train_data);
+                    auto const test_score = model->test(test_data);
                     results_string += parameter_string + "; " + mode_string + "; "
                                       + std::to_string(diam) + "; " + std::to_string(train_time) + "; "
                                       + train_score.csv_string() + "; " + test_score.csv_string() + "\n";
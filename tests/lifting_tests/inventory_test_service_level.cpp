@@ -1,5 +1,5 @@
 #include "robust_inventory/MultistageInventoryManagementInstanceGeneratorServiceLevel.h"
-#include "../../solvers/aro_policy_solvers/LiftingPolicySolver.h"
+#include "../../solvers/aro_policy_solvers/BreakpointSearch.h"
 #include "../test_helpers/ParallelInstanceEvaluator.h"
 
 int
@@ -95,6 +95,17 @@ main(int argc,
                         lm.solve();
                         return std::make_tuple(lm.runtime(), lm.objective_value());
                     });
+    tester.add_test("SEARCH",
+                    [max_runtime](robust_model::ROModel const& model) {
+                        // the LIFT configurations above, one after the other, since the instances already run
+                        // in parallel
+                        auto search = robust_model::BreakpointSearch(model);
+                        search.add_equidistant_configurations({2, 4});
+                        search.add_full_kappa_induced_configuration();
+                        search.set_runtime_limit(max_runtime);
+                        search.solve();
+                        return std::make_tuple(search.runtime(), search.objective_value());
+                    });
 
 
     for (size_t i = 1; i <= 4; ++i) {
@@ -0,0 +1,41 @@
+#include "robust_inventory/MultistageInventoryManagementInstanceGeneratorServiceLevel.h"
+#include "../test_helpers/SOCBenchmarkTests.h"
+
+// Compares the available backends for the second order cone models.
+// Reported times include building the model, transferring it to the solver and solving it.
+int
+main(int argc,
+     char *argv[]) {
+    std::string run_name = "soc_backend_benchmark_" + helpers::time_stamp();
+    helpers::global_logger.set_logfile("../logs/" + run_name + ".log");
+    helpers::global_logger << "Logging " + run_name;
+    std::ofstream output_stream("../results/" + run_name + ".csv");
+    auto instance_generator = testing::MultistageInventoryManagementInstanceGeneratorServiceLevel();
+    auto tester = testing::ParallelInstanceEvaluator(output_stream, instance_generator);
+
+    double const max_runtime = 3600;
+
+    std::vector<std::pair<std::string, solvers::SolverBase::SOCBackend>> backends = {
+            {"ADMM", solvers::SolverBase::SOCBackend::ADMM}};
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+    backends.emplace_back("GUROBI", solvers::SolverBase::SOCBackend::GUROBI);
+#endif
+    for (auto const& [name, backend]: backends) {
+        testing::add_soc_benchmark_tests(tester, name, max_runtime, [backend](solvers::SolverBase& solver) {
+            solver.set_soc_backend(backend);
+        });
+    }
+
+    for (size_t i = 1; i <= 4; ++i) {
+        instance_generator.add_num_stages(5 * i);
+    }
+    instance_generator.add_alpha(0.);
+    instance_generator.add_service_level(.05);
+    instance_generator.add_set_type(robust_model::UncertaintySet::SpecialSetType::BALL);
+    instance_generator.add_set_type(robust_model::UncertaintySet::SpecialSetType::BOX);
+
+    instance_generator.set_number_of_iterations(3);
+
+    // a single thread, so that the timings do not interfere
+    tester.run_tests(1);
+}
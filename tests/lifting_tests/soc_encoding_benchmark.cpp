@@ -0,0 +1,42 @@
+#include "robust_inventory/MultistageInventoryManagementInstanceGeneratorServiceLevel.h"
+#include "../test_helpers/SOCBenchmarkTests.h"
+
+// Compares the native cone encoding of two norm constraints with the squared quadratic encoding.
+// Both encodings are solved by the barrier method. Reported times include building the model, transferring it to
+// the solver and solving it, the sizes of the models handed to the solver are logged.
+int
+main(int argc,
+     char *argv[]) {
+    std::string run_name = "soc_encoding_benchmark_" + helpers::time_stamp();
+    helpers::global_logger.set_logfile("../logs/" + run_name + ".log");
+    helpers::global_logger << "Logging " + run_name;
+    std::ofstream output_stream("../results/" + run_name + ".csv");
+    auto instance_generator = testing::MultistageInventoryManagementInstanceGeneratorServiceLevel();
+    auto tester = testing::ParallelInstanceEvaluator(output_stream, instance_generator);
+
+    double const max_runtime = 3600;
+    solvers::SolverBase::Parameters parameters;
+    parameters.method = solvers::SolverBase::Parameters::Method::BARRIER;
+
+    for (auto const& [name, encoding]: {
+            std::make_pair(std::string("NATIVE"), solvers::SolverBase::SOCEncoding::NATIVE_CONE),
+            std::make_pair(std::string("SQUARED"), solvers::SolverBase::SOCEncoding::SQUARED_QUADRATIC)}) {
+        testing::add_soc_benchmark_tests(tester, name, max_runtime,
+                                         [parameters, encoding](solvers::SolverBase& solver) {
+                                             solver.set_soc_encoding(encoding);
+                                             solver.set_parameters(parameters);
+                                         });
+    }
+
+    instance_generator.add_num_stages(20);
+    for (double alpha: {0., .25, .5}) {
+        instance_generator.add_alpha(alpha);
+    }
+    instance_generator.add_service_level(.05);
+    instance_generator.add_set_type(robust_model::UncertaintySet::SpecialSetType::BALL);
+
+    instance_generator.set_number_of_iterations(5);
+
+    // a single thread, so that the timings do not interfere
+    tester.run_tests(1);
+}
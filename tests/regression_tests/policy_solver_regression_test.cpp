@@ -0,0 +1,572 @@
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../solvers/aro_policy_solvers/AffineAdjustablePolicySolver.h"
+#include "../../solvers/aro_policy_solvers/BreakpointSearch.h"
+#include "../../solvers/aro_policy_solvers/EqualityEliminationPolicySolver.h"
+#include "../../solvers/aro_policy_solvers/LiftingPolicySolver.h"
+#include "../../models/SOCModelWriter.h"
+#include "../../solvers/soc_solvers/SOCSolverBase.h"
+
+// Regression checks of the policy solvers and the models they build, every check builds small models and compares
+// the results of different solve paths, which have to agree, or compares against known output.
+
+namespace testing {
+
+bool close(double value, double expected, double tolerance = 1e-3) {
+    return std::abs(value - expected) <= tolerance * std::max(1., std::abs(expected));
+}
+
+// two stage model over a union of boxes of the given radius around normally distributed centers
+void build_union_model(robust_model::ROModel& model, size_t num_sets, double radius, unsigned seed) {
+    using namespace robust_model;
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> distribution(0., 1.);
+    auto const u1 = model.add_uncertainty_variable("u1", 0, -10, 10);
+    auto const u2 = model.add_uncertainty_variable("u2", 1, -10, 10);
+    for (size_t i = 0; i < num_sets; ++i) {
+        double const a = distribution(generator);
+        double const b = distribution(generator);
+        model.add_uncertainty_constraint(u1 >= a - radius, "LB1");
+        model.add_uncertainty_constraint(u1 <= a + radius, "UB1");
+        model.add_uncertainty_constraint(u2 >= b - radius, "LB2");
+        model.add_uncertainty_constraint(u2 <= b + radius, "UB2");
+        if (i + 1 < num_sets) {
+            model.add_uncertainty_constraint_set();
+        }
+    }
+    auto const x = model.add_decision_variable("x", 0, 0.);
+    auto const y = model.add_decision_variable("y", 1, 0.);
+    auto const z = model.add_decision_variable("z", 2, 0.);
+    model.add_constraint(x + y >= u1 + 0.5 * u2, "c1");
+    model.add_constraint(z >= 2. * u2 - y, "c2");
+    model.add_constraint(y + z >= 1. - u1, "c3");
+    model.set_objective(RoAffineExpression(3. * x + y + z), ObjectiveSense::MIN);
+}
+
+// copies the constants of the uncertainty constraints of other, which has the same structure
+void copy_uncertainty_constants(robust_model::ROModel& model, robust_model::ROModel const& other) {
+    auto const& sets = model.uncertainty_set().constraint_sets();
+    auto const& other_sets = other.uncertainty_set().constraint_sets();
+    for (size_t i = 0; i < sets.size(); ++i) {
+        auto const& other_constraints = other.uncertainty_set().uncertainty_constraints(other_sets[i]);
+        for (size_t j = 0; j < other_constraints.size(); ++j) {
+            model.set_uncertainty_constraint_constant(sets[i], j,
+                                                      other_constraints[j].soc_expression().affine().constant());
+        }
+    }
+}
+
+// uncertainty sets added by constraint generation after a parametric update have to use the updated constants
+bool constraint_generation_after_parametric_update() {
+    size_t const num_sets = 12;
+    robust_model::ROModel model("Union");
+    build_union_model(model, num_sets, 0.1, 3);
+    robust_model::AffineAdjustablePolicySolver solver(model);
+    solver.set_parametric_uncertainty_set(true);
+    solver.set_constraint_generation(true);
+    solver.set_constraint_generation_tolerance(1e-5);
+    solver.solve();
+
+    robust_model::ROModel retrained("Retrained");
+    // other centers, so that constraint generation adds other sets after the update
+    build_union_model(retrained, num_sets, 0.5, 5);
+    copy_uncertainty_constants(model, retrained);
+    solver.solve();
+
+    robust_model::AffineAdjustablePolicySolver reference(retrained);
+    reference.solve();
+    std::cout << "retrained " << solver.objective_value() << " rebuilt " << reference.objective_value() << std::endl;
+    return solver.has_solution() and reference.has_solution() and
+           close(solver.objective_value(), reference.objective_value());
+}
+
+// inventory model over a budget set, whose budget is the first uncertainty constraint
+void build_inventory_model(robust_model::ROModel& model, size_t num_periods, double budget) {
+    using namespace robust_model;
+    auto const demands = model.add_uncertainty_variables_for_each_period(num_periods, "d", 1, 3., 7.);
+    model.add_uncertainty_constraint(LinearExpression<UncertaintyVariable::Reference>::sum(demands) <= budget,
+                                     "Budget");
+    auto const orders = model.add_decision_variables_for_each_period(num_periods, "o", 0, 0., 8.);
+    auto const stocks = model.add_decision_variables_for_each_period(num_periods, "I", 1, NO_VARIABLE_LB,
+                                                                     NO_VARIABLE_UB);
+    auto const holdings = model.add_decision_variables_for_each_period(num_periods, "H", 1, 0., NO_VARIABLE_UB);
+    RoAffineExpression cost(0.);
+    for (size_t t = 0; t < num_periods; ++t) {
+        RoAffineExpression flow = t == 0 ? RoAffineExpression(1. * stocks[t]) - 2.
+                                         : RoAffineExpression(stocks[t] - stocks[t - 1]);
+        model.add_constraint(ROModel::RoConstraint{"Flow" + std::to_string(t), ConstraintSense::EQ,
+                                                   flow - orders[t] + demands[t]});
+        model.add_constraint(holdings[t] >= 1. * stocks[t], "Hold" + std::to_string(t));
+        model.add_constraint(holdings[t] >= -3. * stocks[t], "Back" + std::to_string(t));
+        cost += RoAffineExpression(1. * orders[t] + 1. * holdings[t]);
+    }
+    model.set_objective(cost, ObjectiveSense::MIN);
+}
+
+// objective values kept by lexicographic reoptimization have to be recomputed after a parametric update
+bool lexicographic_reoptimization_after_parametric_update() {
+    size_t const num_periods = 3;
+    std::vector<double> const nominal(num_periods, 5.);
+    auto const solve_lexicographically = [&](robust_model::AffineAdjustablePolicySolver& solver) {
+        solver.set_lexicographic_reoptimization(true);
+        solver.set_lexicographic_tolerance(1e-4);
+        // outdated kept objective values may leave the reoptimization without convergence
+        solver.set_runtime_limit(300);
+        solver.build();
+        solver.add_reoptimization_objective_for_realization(robust_model::UncertaintyRealization(nominal));
+        solver.solve();
+    };
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, num_periods, 5. * num_periods + 2.);
+    robust_model::AffineAdjustablePolicySolver solver(model);
+    solver.set_parametric_uncertainty_set(true);
+    solve_lexicographically(solver);
+    // a smaller budget lowers the worst case, the kept objective value of the old budget is not optimal anymore
+    model.set_uncertainty_constraint_constant(model.uncertainty_set().constraint_sets().front(), 0,
+                                              -4. * num_periods);
+    solver.solve();
+
+    robust_model::ROModel updated("Updated");
+    build_inventory_model(updated, num_periods, 4. * num_periods);
+    robust_model::AffineAdjustablePolicySolver reference(updated);
+    solve_lexicographically(reference);
+    if (not solver.has_solution() or not reference.has_solution()) {
+        return false;
+    }
+    double const nominal_value = solver.specific_solution(nominal).objective_value();
+    double const reference_nominal_value = reference.specific_solution(nominal).objective_value();
+    std::cout << "updated " << solver.objective_value() << " / " << nominal_value << " rebuilt "
+              << reference.objective_value() << " / " << reference_nominal_value << std::endl;
+    return close(solver.objective_value(), reference.objective_value()) and
+           close(nominal_value, reference_nominal_value);
+}
+
+// the dual objective of a barrier iterate, which is not dual feasible yet, must not prune a break point search
+bool no_bound_of_dual_infeasible_iterate() {
+    solvers::SolverBase::Progress progress;
+    // above the optimal value 1 of a minimization, so that it would prune every configuration
+    progress.set_interior_point_bound(2., 1e-2, 1e-6);
+    if (progress.objective_bound) {
+        return false;
+    }
+    progress.set_interior_point_bound(1., 1e-8, 1e-6);
+    return progress.objective_bound == 1.;
+}
+
+// small mixed integer model with a two norm cone and a row without variables
+void build_writer_model(robust_model::SOCModel& model) {
+    using namespace robust_model;
+    using Affine = AffineExpression<SOCVariable::Reference>;
+    auto const x = model.add_variable("x", 0, 4);
+    auto const y = model.add_variable("y");
+    auto const z = model.add_variable("z", 0, 3, VariableType::Integer);
+    model.add_constraint(x + y <= 3., "Sum");
+    model.add_constraint(SOCExpression<SOCVariable>::norm(std::vector<Affine>{Affine(x - 1.), Affine(1. * y)})
+                         <= z + 2., "Cone");
+    model.add_constraint(RawConstraint<Affine>(ConstraintSense::LEQ, Affine(-1.)), "Empty");
+    model.clear_and_set_objective(SOCModel::Objective(ObjectiveSense::MIN, Affine(x + 2. * y - z)));
+}
+
+// the written files are compared to known good output, a multi objective model is rejected by every format
+bool soc_model_writer_output() {
+    using Format = robust_model::SOCModelWriter::Format;
+    std::vector<std::pair<Format, std::string>> const expected_outputs = {
+            {Format::MPS, R"(NAME Writer_test
+ROWS
+ N  obj
+ L  c0
+ E  c1
+ E  c2
+ E  c3
+ L  c4
+ L  q0
+COLUMNS
+    x0 obj 1
+    x0 c0 1
+    x0 c2 1
+    x1 obj 2
+    x1 c0 1
+    x1 c3 1
+    MARKER    'MARKER'    'INTORG'
+    x2 obj -1
+    x2 c1 -1
+    MARKER    'MARKER'    'INTEND'
+    x3 c1 1
+    x4 c2 -1
+    x5 c3 -1
+RHS
+    rhs c0 3
+    rhs c1 2
+    rhs c2 1
+    rhs c4 1
+BOUNDS
+ UP bnd x0 4
+ FR bnd x1
+ UP bnd x2 3
+ FR bnd x4
+ FR bnd x5
+QCMATRIX   q0
+    x4 x4 1
+    x5 x5 1
+    x3 x3 -1
+ENDATA
+)"},
+            {Format::LP, R"(\ Writer_test
+Minimize
+ obj: + 1 x0 + 2 x1 - 1 x2
+Subject To
+ c0: + 1 x0 + 1 x1 <= 3
+ c1: - 1 x2 + 1 x3 = 2
+ c2: + 1 x0 - 1 x4 = 1
+ c3: + 1 x1 - 1 x5 = 0
+ q0: [ x4 ^2 + x5 ^2 - x3 ^2 ] <= 0
+ c4: 0 <= 1
+Bounds
+ 0 <= x0 <= 4
+ x1 free
+ 0 <= x2 <= 3
+ x4 free
+ x5 free
+Generals
+ x2
+End
+)"},
+            {Format::CBF, R"(# Writer_test
+VER
+3
+
+OBJSENSE
+MIN
+
+VAR
+3 1
+F 3
+
+INT
+1
+2
+
+CON
+9 2
+L+ 6
+Q 3
+
+OBJACOORD
+3
+0 1
+1 2
+2 -1
+
+ACOORD
+9
+0 0 1
+1 0 -1
+2 2 1
+3 2 -1
+4 0 -1
+4 1 -1
+6 2 1
+7 0 1
+8 1 1
+
+BCOORD
+6
+1 4
+3 3
+4 3
+5 1
+6 2
+7 -1
+)"}};
+    robust_model::SOCModel model("Writer test");
+    build_writer_model(model);
+    robust_model::SOCModel multi_objective_model("Multi objective");
+    build_writer_model(multi_objective_model);
+    multi_objective_model.add_objective(model.objective());
+    bool passed = true;
+    for (auto const& [format, expected_output]: expected_outputs) {
+        std::ostringstream stream;
+        robust_model::SOCModelWriter(model).write(stream, format);
+        if (stream.str() != expected_output) {
+            std::cout << "unexpected output:\n" << stream.str() << std::endl;
+            passed = false;
+        }
+        try {
+            std::ostringstream multi_objective_stream;
+            robust_model::SOCModelWriter(multi_objective_model).write(multi_objective_stream, format);
+            passed = false;
+        } catch (helpers::MyException const&) {
+        }
+    }
+    return passed;
+}
+
+// min x + 3 y + z + s over a fixed variable f, the singleton row of s, the redundant parallel row of the budget and
+// an empty row after fixing f; presolve removes all of them
+void build_presolve_model(robust_model::SOCModel& model, bool const with_cone) {
+    using namespace robust_model;
+    using Affine = AffineExpression<SOCVariable::Reference>;
+    auto const x = model.add_variable("x", 0, NO_VARIABLE_UB);
+    auto const y = model.add_variable("y", 0, NO_VARIABLE_UB);
+    auto const z = model.add_variable("z", 0, NO_VARIABLE_UB);
+    auto const s = model.add_variable("s");
+    auto const f = model.add_variable("f", 2, 2);
+    model.add_constraint(x + y + f >= 3., "Parallel");
+    model.add_constraint(2. * x + 2. * y >= 4., "Budget");
+    model.add_constraint(RawConstraint<Affine>(ConstraintSense::EQ, Affine(2. * s - 3.)), "Singleton");
+    model.add_constraint(x - z - s <= 0., "Link");
+    model.add_constraint(1. * f <= 3., "Empty");
+    if (with_cone) {
+        model.add_constraint(SOCExpression<SOCVariable>::norm(std::vector<Affine>{Affine(x - 1.), Affine(1. * z)})
+                             <= y + 3., "Cone");
+    }
+    model.clear_and_set_objective(SOCModel::Objective(ObjectiveSense::MIN, Affine(x + 3. * y + z + s)));
+}
+
+// the solution and, if the plain solve has them, the dual values and reduced costs agree
+bool same_results(robust_model::SOCModel const& presolved, robust_model::SOCModel const& plain) {
+    bool same = true;
+    for (size_t j = 0; j < plain.variables().size(); ++j) {
+        auto const& var = plain.variables()[j];
+        auto const& presolved_var = presolved.variables()[j];
+        same = same and close(presolved_var.solution(), var.solution());
+        if (var.has_reduced_cost()) {
+            same = same and presolved_var.has_reduced_cost()
+                   and close(presolved_var.reduced_cost(), var.reduced_cost());
+        }
+    }
+    for (size_t i = 0; i < plain.soc_constraints().size(); ++i) {
+        auto const& constr = plain.soc_constraints()[i];
+        auto const& presolved_constr = presolved.soc_constraints()[i];
+        if (constr.has_dual_value()) {
+            same = same and presolved_constr.has_dual_value()
+                   and close(presolved_constr.dual_value(), constr.dual_value());
+        }
+    }
+    return same;
+}
+
+// presolved solves match plain solves, also after updates applied to the reduced model and after an update,
+// which needs a new presolve
+bool presolved_solutions_agree(bool const with_cone) {
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+    auto const backend = solvers::SolverBase::SOCBackend::GUROBI;
+#else
+    auto const backend = solvers::SolverBase::SOCBackend::ADMM;
+#endif
+    robust_model::SOCModel presolved_model("Presolved");
+    robust_model::SOCModel plain_model("Plain");
+    build_presolve_model(presolved_model, with_cone);
+    build_presolve_model(plain_model, with_cone);
+    auto const presolved_solver = solvers::SOCSolverBase::create(backend, presolved_model, true);
+    auto const plain_solver = solvers::SOCSolverBase::create(backend, plain_model);
+    auto const solve_and_compare = [&](std::string const& stage) {
+        presolved_solver->solve();
+        plain_solver->solve();
+        std::cout << stage << " presolved " << presolved_solver->objective_value() << " plain "
+                  << plain_solver->objective_value() << std::endl;
+        return presolved_solver->has_solution() and plain_solver->has_solution()
+               and close(presolved_solver->objective_value(), plain_solver->objective_value())
+               and same_results(presolved_model, plain_model);
+    };
+    auto const change = [&](auto const& apply) {
+        apply(presolved_model);
+        apply(plain_model);
+    };
+    bool passed = solve_and_compare("initial");
+    // the link row is kept, the added row is appended to the reduced model
+    change([](robust_model::SOCModel& model) {
+        model.set_coefficients(3, {{model.variables()[2].reference(), -2.}});
+        model.add_constraint(1. * model.variables()[0].reference() <= 1.8, "Cap");
+    });
+    passed = solve_and_compare("updated") and passed;
+    // the parallel row was removed, the model is presolved again
+    change([](robust_model::SOCModel& model) {
+        model.set_coefficients(0, {{model.variables()[0].reference(), 3.}});
+    });
+    return solve_and_compare("presolved again") and passed;
+}
+
+bool presolved_affine_solutions_agree() {
+    return presolved_solutions_agree(false);
+}
+
+bool presolved_conic_solutions_agree() {
+    return presolved_solutions_agree(true);
+}
+
+// eliminating the stock variables defined by the flow equalities keeps the optimal affine policy
+bool equality_elimination_matches_affine_policy() {
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, 4, 22.);
+    robust_model::EqualityEliminationPolicySolver eliminated(model);
+    eliminated.solve();
+    robust_model::AffineAdjustablePolicySolver reference(model);
+    reference.solve();
+    std::cout << "eliminated " << eliminated.objective_value() << " affine " << reference.objective_value()
+              << std::endl;
+    if (not eliminated.has_solution() or not reference.has_solution()
+        or eliminated.eliminator().num_eliminated_variables() == 0) {
+        return false;
+    }
+    std::vector<double> const nominal(4, 5.);
+    auto const solution = eliminated.specific_solution(nominal);
+    return close(eliminated.objective_value(), reference.objective_value()) and solution.feasible()
+           and solution.solutions().size() == model.num_dvars();
+}
+
+// the counterparts built by several threads give the same soc model as the sequential build
+bool parallel_counterpart_build_matches_sequential() {
+    robust_model::ROModel model("Union");
+    build_union_model(model, 6, 0.2, 7);
+    robust_model::AffineAdjustablePolicySolver parallel(model);
+    parallel.set_build_threads(3);
+    parallel.solve();
+    robust_model::AffineAdjustablePolicySolver sequential(model);
+    sequential.solve();
+    std::cout << "parallel " << parallel.objective_value() << " " << parallel.model_size().to_string()
+              << " sequential " << sequential.objective_value() << " " << sequential.model_size().to_string()
+              << std::endl;
+    return parallel.has_solution() and sequential.has_solution()
+           and close(parallel.objective_value(), sequential.objective_value())
+           and parallel.model_size().to_string() == sequential.model_size().to_string();
+}
+
+// the batch evaluation of the policies agrees with the specific solutions of the solver
+bool policy_evaluator_matches_specific_solutions() {
+    size_t const num_periods = 4;
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, num_periods, 22.);
+    robust_model::AffineAdjustablePolicySolver solver(model);
+    solver.solve();
+    if (not solver.has_solution()) {
+        return false;
+    }
+    size_t const num_samples = 20;
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> distribution(3., 7.);
+    std::vector<double> realizations(num_samples * model.num_uvars());
+    for (auto& value: realizations) {
+        value = distribution(generator);
+    }
+    auto const evaluator = solver.policy_evaluator();
+    std::vector<double> solutions;
+    evaluator.evaluate(realizations, solutions);
+    for (size_t k = 0; k < num_samples; ++k) {
+        std::vector<double> const realization(realizations.begin() + k * model.num_uvars(),
+                                              realizations.begin() + (k + 1) * model.num_uvars());
+        auto const expected = solver.specific_solution(realization).solutions();
+        for (size_t j = 0; j < model.num_dvars(); ++j) {
+            if (not close(solutions[k * model.num_dvars() + j], expected[j], 1e-9)) {
+                std::cout << "sample " << k << " decision " << j << ": " << solutions[k * model.num_dvars() + j]
+                          << " instead of " << expected[j] << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// refinements start from the previous policy, which has to give the policy of the final break points nonetheless
+bool refined_lifting_matches_direct_lifting() {
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, 3, 17.);
+    robust_model::LiftingPolicySolver refined(model);
+    refined.add_equidistant_breakpoints(2);
+    refined.set_adaptive_refinement(2);
+    refined.solve();
+    robust_model::LiftingPolicySolver direct(model);
+    for (auto const& break_point_series: refined.break_point_series()) {
+        direct.add_break_points(break_point_series.break_points(), break_point_series.break_point_direction());
+    }
+    direct.solve();
+    std::cout << "refined " << refined.objective_value() << " in " << refined.runtime() << "s direct "
+              << direct.objective_value() << std::endl;
+    return refined.has_solution() and direct.has_solution()
+           and close(refined.objective_value(), direct.objective_value());
+}
+
+// static orders cannot react to the demands, so the bounds ADMM reports once its iterate is dual feasible have to
+// prune the second configuration against the affine policy
+bool breakpoint_search_prunes_dominated_configuration() {
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, 3, 17.);
+    robust_model::BreakpointSearch search(model);
+    search.add_equidistant_configurations({1});
+    search.add_configuration("STATIC", [](robust_model::LiftingPolicySolver& solver) {
+        solver.add_equidistant_breakpoints(1);
+        solver.set_dependency_pattern([](robust_model::DecisionVariable const& decision,
+                                         robust_model::UncertaintyVariable const&) {
+            return decision.name().front() != 'o';
+        });
+    });
+    search.set_soc_backend(solvers::SolverBase::SOCBackend::ADMM);
+    search.solve();
+    auto const& candidates = search.candidates();
+    std::cout << "affine " << candidates[0].objective_value.value_or(NAN)
+              << (candidates[1].pruned ? " static pruned" : " static not pruned") << std::endl;
+    return search.has_solution() and not candidates[0].pruned and candidates[1].pruned and
+           search.best_candidate().name == candidates[0].name;
+}
+
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+// more pieces never make the policy worse, so the second configuration must not be pruned by the bounds gurobi
+// reports during its barrier iterations
+bool breakpoint_search_without_pruning_by_barrier_iterates() {
+    robust_model::ROModel model("Inventory");
+    build_inventory_model(model, 4, 22.);
+    robust_model::BreakpointSearch search(model);
+    search.add_equidistant_configurations({1, 3});
+    search.set_soc_backend(solvers::SolverBase::SOCBackend::GUROBI);
+    auto parameters = search.parameters();
+    parameters.method = solvers::SolverBase::Parameters::Method::BARRIER;
+    parameters.crossover = false;
+    search.set_parameters(parameters);
+    search.solve();
+    auto const& candidates = search.candidates();
+    std::cout << "affine " << candidates[0].objective_value.value_or(NAN) << " lifted "
+              << candidates[1].objective_value.value_or(NAN) << (candidates[1].pruned ? " pruned" : "") << std::endl;
+    return not candidates[1].pruned and candidates[1].objective_value and
+           candidates[1].objective_value.value() <= candidates[0].objective_value.value() + 1e-4;
+}
+#endif
+
+}
+
+int
+main(int argc,
+     char *argv[]) {
+    std::vector<std::pair<std::string, std::function<bool()>>> const checks = {
+            {"constraint_generation_after_parametric_update", testing::constraint_generation_after_parametric_update},
+            {"lexicographic_reoptimization_after_parametric_update",
+             testing::lexicographic_reoptimization_after_parametric_update},
+            {"no_bound_of_dual_infeasible_iterate", testing::no_bound_of_dual_infeasible_iterate},
+            {"soc_model_writer_output", testing::soc_model_writer_output},
+            {"presolved_affine_solutions_agree", testing::presolved_affine_solutions_agree},
+            {"presolved_conic_solutions_agree", testing::presolved_conic_solutions_agree},
+            {"equality_elimination_matches_affine_policy", testing::equality_elimination_matches_affine_policy},
+            {"parallel_counterpart_build_matches_sequential", testing::parallel_counterpart_build_matches_sequential},
+            {"policy_evaluator_matches_specific_solutions", testing::policy_evaluator_matches_specific_solutions},
+            {"refined_lifting_matches_direct_lifting", testing::refined_lifting_matches_direct_lifting},
+            {"breakpoint_search_prunes_dominated_configuration",
+             testing::breakpoint_search_prunes_dominated_configuration},
+#ifdef ROBUSTOPTIMIZATION_WITH_GUROBI
+            {"breakpoint_search_without_pruning_by_barrier_iterates",
+             testing::breakpoint_search_without_pruning_by_barrier_iterates},
+#endif
+    };
+    int failures = 0;
+    for (auto const& [name, check]: checks) {
+        bool const passed = check();
+        std::cout << (passed ? "PASSED " : "FAILED ") << name << std::endl;
+        failures += passed ? 0 : 1;
+    }
+    return failures;
+}
@@ -4,8 +4,18 @@
 #include "DataModelBase.h"
 #include "../../helpers/helpers.h"
 
+#include <concepts>
+#include <memory>
+
 namespace data_models {
 
+// models, which can be trained again for another radius without building from scratch
+template<class Model>
+concept RetrainableModel = requires(Model& model, double radius) {
+    { model.can_retrain(radius) } -> std::convertible_to<bool>;
+    { model.retrain(radius) } -> std::convertible_to<bool>;
+};
+
 template<class BaseModel>
 class CVModel : public DataModelBase {
 public:
@@ -22,6 +32,9 @@ public:
 private:
     std::tuple<SampleData, SampleData> validation_split(size_t cv_seed, SampleData const& training_data) const;
 
+    // trains a new model for the radius, unless the model of the previous radius can be retrained
+    bool train_for_radius(std::unique_ptr<BaseModel>& model, double radius, SampleData const& training_data) const;
+
 private:
     typename BaseModel::Parameter const _parameter;
     std::vector<double> const _radii;
@@ -0,0 +1,34 @@
+#include "SOCBenchmarkTests.h"
+#include "../../solvers/aro_policy_solvers/LiftingPolicySolver.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace testing {
+
+void add_soc_benchmark_tests(ParallelInstanceEvaluator& tester, std::string const& name, double const max_runtime,
+                             std::function<void(solvers::SolverBase&)> const& configure) {
+    auto const timed_solve = [max_runtime, configure](std::string const& test_name, solvers::SolverBase& solver,
+                                                      std::chrono::steady_clock::time_point const& start) {
+        solver.build();
+        solver.set_runtime_limit(max_runtime);
+        configure(solver);
+        solver.solve();
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        helpers::global_logger << test_name + " " + solver.model_size().to_string();
+        return std::make_tuple(solver.has_solution() ? elapsed.count() : std::nan("0"), solver.objective_value());
+    };
+    tester.add_test("AFF_" + name, [name, timed_solve](robust_model::ROModel const& model) {
+        auto const start = std::chrono::steady_clock::now();
+        auto am = robust_model::AffineAdjustablePolicySolver(model);
+        return timed_solve("AFF_" + name, am, start);
+    });
+    tester.add_test("LIFT1_" + name, [name, timed_solve](robust_model::ROModel const& model) {
+        auto const start = std::chrono::steady_clock::now();
+        auto lm = robust_model::LiftingPolicySolver(model);
+        lm.add_equidistant_breakpoints(2);
+        return timed_solve("LIFT1_" + name, lm, start);
+    });
+}
+
+}
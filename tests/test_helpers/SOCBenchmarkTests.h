@@ -0,0 +1,20 @@
+#ifndef ROBUSTOPTIMIZATION_SOCBENCHMARKTESTS_H
+#define ROBUSTOPTIMIZATION_SOCBENCHMARKTESTS_H
+
+#include "ParallelInstanceEvaluator.h"
+#include "../../solvers/SolverBase.h"
+
+#include <functional>
+#include <string>
+
+namespace testing {
+
+// Adds the tests AFF_<name> and LIFT1_<name> solving the affine and the once lifted policies with the solver options
+// set by configure. Reported times include building the model, transferring it to the solver and solving it, the
+// sizes of the models handed to the solver are logged.
+void add_soc_benchmark_tests(ParallelInstanceEvaluator& tester, std::string const& name, double max_runtime,
+                             std::function<void(solvers::SolverBase&)> const& configure);
+
+}
+
+#endif //ROBUSTOPTIMIZATION_SOCBENCHMARKTESTS_H